@@ -0,0 +1,664 @@
+#include "vector.h"
+#include "flat_map.h"
+#include "pool_allocator.h"
+#include "instrumented.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// Наибольший объём элементов одного контейнера. Размеры перебираются от 1 до 10^8 степенями десяти,
+// но не превышают этот объём: для крупных типов верхняя граница соответственно меньше
+#ifndef ADVANCED_VECTOR_BENCHMARK_MAX_BYTES
+#define ADVANCED_VECTOR_BENCHMARK_MAX_BYTES (size_t{1} << 30)
+#endif
+
+// Счётчики выделений памяти через глобальный operator new
+namespace {
+
+size_t num_allocations = 0;
+size_t num_allocated_bytes = 0;
+
+void* CountedAllocate(size_t size) {
+    ++num_allocations;
+    num_allocated_bytes += size;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* CountedAllocate(size_t size, std::align_val_t alignment) {
+    ++num_allocations;
+    num_allocated_bytes += size;
+    const auto align = static_cast<size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+    return CountedAllocate(size);
+}
+
+void* operator new[](size_t size) {
+    return CountedAllocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return CountedAllocate(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return CountedAllocate(size, alignment);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t /*size*/) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t /*size*/) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t /*alignment*/) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t /*alignment*/) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// Обёртка, подсчитывающая объём данных, скопированных и перемещённых конструкторами и присваиваниями.
+// Для тривиально копируемых типов такой подсчёт невозможен без потери тривиальности,
+// поэтому они измеряются без обёртки
+template <typename T>
+struct Tracked {
+    Tracked() = default;
+
+    explicit Tracked(T value)
+            : value(std::move(value))  //
+    {
+    }
+
+    Tracked(const Tracked& other)
+            : value(other.value)  //
+    {
+        num_transferred_bytes += sizeof(Tracked);
+    }
+
+    Tracked(Tracked&& other) noexcept
+            : value(std::move(other.value))  //
+    {
+        num_transferred_bytes += sizeof(Tracked);
+    }
+
+    Tracked& operator=(const Tracked& other) {
+        value = other.value;
+        num_transferred_bytes += sizeof(Tracked);
+        return *this;
+    }
+
+    Tracked& operator=(Tracked&& other) noexcept {
+        value = std::move(other.value);
+        num_transferred_bytes += sizeof(Tracked);
+        return *this;
+    }
+
+    T value{};
+
+    static inline size_t num_transferred_bytes = 0;
+};
+
+struct Pod64 {
+    int64_t fields[8];
+};
+
+using String = Tracked<std::string>;
+using MoveOnly = Tracked<std::unique_ptr<int>>;
+
+template <typename T>
+T MakeValue(size_t i) {
+    if constexpr (std::is_same_v<T, int>) {
+        return static_cast<int>(i);
+    } else if constexpr (std::is_same_v<T, Pod64>) {
+        return Pod64{{static_cast<int64_t>(i)}};
+    } else if constexpr (std::is_same_v<T, String>) {
+        // Короткая строка помещается в SSO и не выделяет память сама по себе
+        return String(std::to_string(i));
+    } else {
+        return MoveOnly(std::make_unique<int>(static_cast<int>(i)));
+    }
+}
+
+template <typename T>
+size_t TransferredBytes() {
+    if constexpr (std::is_same_v<T, String> || std::is_same_v<T, MoveOnly>) {
+        return T::num_transferred_bytes;
+    } else {
+        return 0;
+    }
+}
+
+// Единый интерфейс к std::vector и Vector
+template <typename Container>
+struct Adapter;
+
+template <typename T>
+struct Adapter<std::vector<T>> {
+    using Value = T;
+
+    static void Reserve(std::vector<T>& v, size_t capacity) {
+        v.reserve(capacity);
+    }
+
+    static void PushBack(std::vector<T>& v, T&& value) {
+        v.push_back(std::move(value));
+    }
+
+    template <typename... Args>
+    static void EmplaceBack(std::vector<T>& v, Args&&... args) {
+        v.emplace_back(std::forward<Args>(args)...);
+    }
+
+    static void Insert(std::vector<T>& v, size_t index, T&& value) {
+        v.insert(v.begin() + index, std::move(value));
+    }
+
+    static void Erase(std::vector<T>& v, size_t index) {
+        v.erase(v.begin() + index);
+    }
+
+    static size_t Size(const std::vector<T>& v) {
+        return v.size();
+    }
+};
+
+template <typename T>
+struct Adapter<Vector<T>> {
+    using Value = T;
+
+    static void Reserve(Vector<T>& v, size_t capacity) {
+        v.Reserve(capacity);
+    }
+
+    static void PushBack(Vector<T>& v, T&& value) {
+        v.PushBack(std::move(value));
+    }
+
+    template <typename... Args>
+    static void EmplaceBack(Vector<T>& v, Args&&... args) {
+        v.EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    static void Insert(Vector<T>& v, size_t index, T&& value) {
+        v.Insert(v.begin() + index, std::move(value));
+    }
+
+    static void Erase(Vector<T>& v, size_t index) {
+        v.Erase(v.begin() + index);
+    }
+
+    static size_t Size(const Vector<T>& v) {
+        return v.Size();
+    }
+};
+
+// Накапливает число выделений памяти и перенесённых байт на измеряемых участках
+template <typename T>
+class Stats {
+public:
+    void Begin() {
+        allocations_ -= num_allocations;
+        allocated_bytes_ -= num_allocated_bytes;
+        transferred_bytes_ -= TransferredBytes<T>();
+    }
+
+    void End() {
+        allocations_ += num_allocations;
+        allocated_bytes_ += num_allocated_bytes;
+        transferred_bytes_ += TransferredBytes<T>();
+    }
+
+    // Публикует счётчики в пересчёте на одну итерацию и время на элементарную операцию
+    void Report(benchmark::State& state, size_t ops_per_iteration) const {
+        using benchmark::Counter;
+        state.counters["time/op"] = Counter(static_cast<double>(ops_per_iteration),
+                                            Counter::kIsIterationInvariantRate | Counter::kInvert);
+        state.counters["allocs"] = Counter(static_cast<double>(allocations_), Counter::kAvgIterations);
+        state.counters["bytes_allocated"] = Counter(static_cast<double>(allocated_bytes_),
+                                                    Counter::kAvgIterations, Counter::kIs1024);
+        if constexpr (!std::is_trivially_copyable_v<T>) {
+            state.counters["bytes_copied"] = Counter(static_cast<double>(transferred_bytes_),
+                                                     Counter::kAvgIterations, Counter::kIs1024);
+        }
+    }
+
+private:
+    size_t allocations_ = 0;
+    size_t allocated_bytes_ = 0;
+    size_t transferred_bytes_ = 0;
+};
+
+template <typename Container>
+Container MakeFilled(size_t size) {
+    using A = Adapter<Container>;
+    Container c;
+    A::Reserve(c, size);
+    for (size_t i = 0; i < size; ++i) {
+        A::PushBack(c, MakeValue<typename A::Value>(i));
+    }
+    return c;
+}
+
+// Время участка замеряется вручную, чтобы подготовка данных не попадала в результат
+template <typename T, typename Body>
+void RunManual(benchmark::State& state, Stats<T>& stats, Body body) {
+    const auto start = std::chrono::steady_clock::now();
+    stats.Begin();
+    body();
+    stats.End();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    state.SetIterationTime(elapsed.count());
+}
+
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    using A = Adapter<Container>;
+    using T = typename A::Value;
+    const auto size = static_cast<size_t>(state.range(0));
+    Stats<T> stats;
+    for (auto _ : state) {
+        stats.Begin();
+        Container c;
+        for (size_t i = 0; i < size; ++i) {
+            A::PushBack(c, MakeValue<T>(i));
+        }
+        benchmark::DoNotOptimize(c);
+        stats.End();
+    }
+    stats.Report(state, size);
+}
+
+template <typename Container>
+void BM_EmplaceBack(benchmark::State& state) {
+    using A = Adapter<Container>;
+    using T = typename A::Value;
+    const auto size = static_cast<size_t>(state.range(0));
+    Stats<T> stats;
+    for (auto _ : state) {
+        stats.Begin();
+        Container c;
+        for (size_t i = 0; i < size; ++i) {
+            A::EmplaceBack(c, MakeValue<T>(i));
+        }
+        benchmark::DoNotOptimize(c);
+        stats.End();
+    }
+    stats.Report(state, size);
+}
+
+// Добавление в заранее зарезервированный контейнер: обе реализации проверяют ёмкость на каждой вставке,
+// поэтому сравнивается именно быстрый путь EmplaceBack
+template <typename Container>
+void BM_EmplaceBackReserved(benchmark::State& state) {
+    using A = Adapter<Container>;
+    using T = typename A::Value;
+    const auto size = static_cast<size_t>(state.range(0));
+    Stats<T> stats;
+    for (auto _ : state) {
+        stats.Begin();
+        Container c;
+        A::Reserve(c, size);
+        for (size_t i = 0; i < size; ++i) {
+            A::EmplaceBack(c, MakeValue<T>(i));
+        }
+        benchmark::DoNotOptimize(c);
+        stats.End();
+    }
+    stats.Report(state, size);
+}
+
+// То же через UncheckedEmplaceBack без проверки ёмкости: нижняя граница для быстрого пути.
+// У std::vector аналога нет, поэтому измеряется только Vector
+template <typename T>
+void BM_UncheckedEmplaceBackReserved(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    Stats<T> stats;
+    for (auto _ : state) {
+        stats.Begin();
+        Vector<T> v;
+        v.Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            v.UncheckedEmplaceBack(MakeValue<T>(i));
+        }
+        benchmark::DoNotOptimize(v);
+        stats.End();
+    }
+    stats.Report(state, size);
+}
+
+// Рост ёмкости заполненного контейнера вдвое: стоимость переноса всех элементов
+template <typename Container>
+void BM_Reserve(benchmark::State& state) {
+    using A = Adapter<Container>;
+    using T = typename A::Value;
+    const auto size = static_cast<size_t>(state.range(0));
+    Stats<T> stats;
+    for (auto _ : state) {
+        Container c = MakeFilled<Container>(size);
+        RunManual(state, stats, [&] {
+            A::Reserve(c, size * 2);
+        });
+        benchmark::DoNotOptimize(c);
+    }
+    stats.Report(state, size);
+}
+
+// Вставка в середину и удаление из середины: две операции на итерацию, размер не меняется
+template <typename Container>
+void BM_InsertEraseMiddle(benchmark::State& state) {
+    using A = Adapter<Container>;
+    using T = typename A::Value;
+    const auto size = static_cast<size_t>(state.range(0));
+    Container c = MakeFilled<Container>(size);
+    // Запас ёмкости, чтобы измерялся сдвиг хвоста, а не реаллокация
+    A::Reserve(c, size + 1);
+    Stats<T> stats;
+    for (auto _ : state) {
+        stats.Begin();
+        A::Insert(c, size / 2, MakeValue<T>(size));
+        A::Erase(c, size / 2);
+        stats.End();
+        benchmark::DoNotOptimize(c);
+    }
+    stats.Report(state, 2);
+}
+
+template <typename Container>
+void BM_Copy(benchmark::State& state) {
+    using T = typename Adapter<Container>::Value;
+    const auto size = static_cast<size_t>(state.range(0));
+    const Container source = MakeFilled<Container>(size);
+    Stats<T> stats;
+    for (auto _ : state) {
+        stats.Begin();
+        Container copy(source);
+        benchmark::DoNotOptimize(copy);
+        stats.End();
+    }
+    stats.Report(state, size);
+}
+
+// Присваивание в контейнер той же длины: копирование на месте, без выделения памяти
+template <typename Container>
+void BM_Assign(benchmark::State& state) {
+    using T = typename Adapter<Container>::Value;
+    const auto size = static_cast<size_t>(state.range(0));
+    const Container source = MakeFilled<Container>(size);
+    Container target = MakeFilled<Container>(size);
+    Stats<T> stats;
+    for (auto _ : state) {
+        stats.Begin();
+        target = source;
+        benchmark::DoNotOptimize(target);
+        stats.End();
+    }
+    stats.Report(state, size);
+}
+
+template <typename T>
+size_t Weight(const T& value) {
+    if constexpr (std::is_same_v<T, int>) {
+        return static_cast<size_t>(value);
+    } else if constexpr (std::is_same_v<T, Pod64>) {
+        return static_cast<size_t>(value.fields[0]);
+    } else if constexpr (std::is_same_v<T, String>) {
+        return value.value.size();
+    } else {
+        return static_cast<size_t>(*value.value);
+    }
+}
+
+template <typename Container>
+void BM_Iterate(benchmark::State& state) {
+    using T = typename Adapter<Container>::Value;
+    const auto size = static_cast<size_t>(state.range(0));
+    const Container c = MakeFilled<Container>(size);
+    Stats<T> stats;
+    for (auto _ : state) {
+        stats.Begin();
+        size_t sum = 0;
+        for (const T& value : c) {
+            sum += Weight(value);
+        }
+        benchmark::DoNotOptimize(sum);
+        stats.End();
+    }
+    stats.Report(state, size);
+}
+
+// Обращения через operator[] при разных политиках проверки индексов: последовательный обход по индексу,
+// в котором проверка выносится из цикла, и выборка по заранее перемешанным индексам, где она остаётся
+template <typename BoundsCheck>
+using IndexedVector = Vector<int, std::allocator<int>, DoublingGrowth, NoStats, BoundsCheck>;
+
+template <typename BoundsCheck>
+void BM_IndexedSum(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    IndexedVector<BoundsCheck> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<int>(i);
+    }
+    for (auto _ : state) {
+        long sum = 0;
+        for (size_t i = 0; i < v.Size(); ++i) {
+            sum += v[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+template <typename BoundsCheck>
+void BM_IndexedGather(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    IndexedVector<BoundsCheck> v(size);
+    Vector<uint32_t> indices(size);
+    uint64_t seed = 0x9E3779B97F4A7C15;
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<int>(i);
+        seed = seed * 6364136223846793005 + 1442695040888963407;
+        indices[i] = static_cast<uint32_t>((seed >> 33) % size);
+    }
+    for (auto _ : state) {
+        long sum = 0;
+        for (uint32_t index : indices) {
+            sum += v[index];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// Поиск случайных ключей, половина которых отсутствует: FlatMap против std::map
+const int* FindValue(const std::map<int, int>& map, int key) {
+    const auto it = map.find(key);
+    return it != map.end() ? &it->second : nullptr;
+}
+
+const int* FindValue(const FlatMap<int, int>& map, int key) {
+    return map.Find(key);
+}
+
+template <typename Map>
+void BM_MapFind(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    std::vector<std::pair<int, int>> pairs;
+    for (size_t i = 0; i < size; ++i) {
+        pairs.emplace_back(static_cast<int>(2 * i), static_cast<int>(i));
+    }
+    const Map map(pairs.begin(), pairs.end());
+    Vector<int> keys(size);
+    uint64_t seed = 0x9E3779B97F4A7C15;
+    for (int& key : keys) {
+        seed = seed * 6364136223846793005 + 1442695040888963407;
+        key = static_cast<int>((seed >> 33) % (2 * size));
+    }
+    for (auto _ : state) {
+        size_t found = 0;
+        for (int key : keys) {
+            found += FindValue(map, key) != nullptr;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+// Векторы, которые создаются, заполняются и разрушаются один за другим, как в обработчиках запросов:
+// с PoolAllocator буферы берутся из пула потока вместо malloc
+template <typename V>
+void BM_CreateDestroy(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    size_t step = 0;
+    for (auto _ : state) {
+        V v;
+        v.Reserve(size - step % 8);
+        for (size_t i = 0; i < size / 2; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(v.Data());
+        ++step;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+struct OperationsTag {};
+using CountedElement = Instrumented<OperationsTag>;
+using CountedCopyOnGrowth = Instrumented<OperationsTag, false>;
+using CountedRelocatable = Instrumented<OperationsTag, true, true>;
+
+template <typename T>
+using InstrumentedStdVector = std::vector<T, CountingAllocator<T, OperationsTag>>;
+
+template <typename T>
+using InstrumentedVector = Vector<T, CountingAllocator<T, OperationsTag>>;
+
+// Заполнение без Reserve с подсчётом операций над элементами в пересчёте на один элемент:
+// показывает, во что обходится рост контейнера помимо времени
+template <typename Container>
+void BM_GrowthOperations(benchmark::State& state) {
+    using benchmark::Counter;
+    using Value = typename Container::value_type;
+    const auto size = static_cast<size_t>(state.range(0));
+    OperationProbe<OperationsTag> probe;
+    for (auto _ : state) {
+        Container c;
+        for (size_t i = 0; i < size; ++i) {
+            c.push_back(Value(static_cast<int>(i)));
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+    const OperationCounts counts = probe.Counts();
+    const auto per_element = static_cast<double>(state.iterations() * size);
+    state.counters["copies/elem"] = static_cast<double>(counts.copied) / per_element;
+    state.counters["moves/elem"] = static_cast<double>(counts.moved) / per_element;
+    state.counters["allocs"] = Counter(static_cast<double>(counts.allocations), Counter::kAvgIterations);
+    state.counters["bytes_allocated"] = Counter(static_cast<double>(counts.allocated_bytes),
+                                                Counter::kAvgIterations, Counter::kIs1024);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+template <typename T>
+void Sizes(benchmark::internal::Benchmark* b) {
+    const size_t max_size = std::min<size_t>(100'000'000, ADVANCED_VECTOR_BENCHMARK_MAX_BYTES / sizeof(T));
+    for (size_t size = 1; size <= max_size; size *= 10) {
+        b->Arg(static_cast<int64_t>(size));
+    }
+}
+
+}  // namespace
+
+#define REGISTER_FOR_TYPE(bm, T) \
+    BENCHMARK_TEMPLATE(bm, std::vector<T>)->Apply(Sizes<T>); \
+    BENCHMARK_TEMPLATE(bm, Vector<T>)->Apply(Sizes<T>)
+
+#define REGISTER_MANUAL_FOR_TYPE(bm, T) \
+    BENCHMARK_TEMPLATE(bm, std::vector<T>)->Apply(Sizes<T>)->UseManualTime(); \
+    BENCHMARK_TEMPLATE(bm, Vector<T>)->Apply(Sizes<T>)->UseManualTime()
+
+#define REGISTER_FOR_COPYABLE(bm) \
+    REGISTER_FOR_TYPE(bm, int); \
+    REGISTER_FOR_TYPE(bm, Pod64); \
+    REGISTER_FOR_TYPE(bm, String)
+
+#define REGISTER_FOR_ALL(bm) \
+    REGISTER_FOR_COPYABLE(bm); \
+    REGISTER_FOR_TYPE(bm, MoveOnly)
+
+REGISTER_FOR_ALL(BM_PushBack);
+REGISTER_FOR_ALL(BM_EmplaceBack);
+REGISTER_FOR_ALL(BM_EmplaceBackReserved);
+BENCHMARK_TEMPLATE(BM_UncheckedEmplaceBackReserved, int)->Apply(Sizes<int>);
+BENCHMARK_TEMPLATE(BM_UncheckedEmplaceBackReserved, Pod64)->Apply(Sizes<Pod64>);
+BENCHMARK_TEMPLATE(BM_UncheckedEmplaceBackReserved, String)->Apply(Sizes<String>);
+BENCHMARK_TEMPLATE(BM_UncheckedEmplaceBackReserved, MoveOnly)->Apply(Sizes<MoveOnly>);
+REGISTER_MANUAL_FOR_TYPE(BM_Reserve, int);
+REGISTER_MANUAL_FOR_TYPE(BM_Reserve, Pod64);
+REGISTER_MANUAL_FOR_TYPE(BM_Reserve, String);
+REGISTER_MANUAL_FOR_TYPE(BM_Reserve, MoveOnly);
+REGISTER_FOR_ALL(BM_InsertEraseMiddle);
+REGISTER_FOR_COPYABLE(BM_Copy);
+REGISTER_FOR_COPYABLE(BM_Assign);
+REGISTER_FOR_ALL(BM_Iterate);
+
+#define REGISTER_FOR_BOUNDS_CHECKS(bm) \
+    BENCHMARK_TEMPLATE(bm, UncheckedIndex)->Range(1 << 10, 1 << 22); \
+    BENCHMARK_TEMPLATE(bm, CheckedIndex)->Range(1 << 10, 1 << 22); \
+    BENCHMARK_TEMPLATE(bm, SampledIndex<>)->Range(1 << 10, 1 << 22)
+
+REGISTER_FOR_BOUNDS_CHECKS(BM_IndexedSum);
+REGISTER_FOR_BOUNDS_CHECKS(BM_IndexedGather);
+
+BENCHMARK_TEMPLATE(BM_MapFind, std::map<int, int>)->Range(1 << 6, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapFind, FlatMap<int, int>)->Range(1 << 6, 1 << 20);
+
+BENCHMARK_TEMPLATE(BM_CreateDestroy, Vector<int>)->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_CreateDestroy, Vector<int, PoolAllocator<int>>)->Range(16, 1 << 16);
+
+#define REGISTER_GROWTH_OPERATIONS(T) \
+    BENCHMARK_TEMPLATE(BM_GrowthOperations, InstrumentedStdVector<T>)->Range(16, 1 << 16); \
+    BENCHMARK_TEMPLATE(BM_GrowthOperations, InstrumentedVector<T>)->Range(16, 1 << 16)
+
+REGISTER_GROWTH_OPERATIONS(CountedElement);
+REGISTER_GROWTH_OPERATIONS(CountedCopyOnGrowth);
+REGISTER_GROWTH_OPERATIONS(CountedRelocatable);
+
+BENCHMARK_MAIN();
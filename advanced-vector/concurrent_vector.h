@@ -0,0 +1,203 @@
+#pragma once
+#include "vector.h"
+
+namespace detail {
+
+// Номер старшего единичного бита ненулевого x
+inline size_t FloorLog2(size_t x) noexcept {
+    assert(x != 0);
+#if defined(__GNUC__)
+    return std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(x);
+#else
+    size_t log = 0;
+    while (x >>= 1) {
+        ++log;
+    }
+    return log;
+#endif
+}
+
+}  // namespace detail
+
+// Вектор с добавлением из многих потоков без блокировок. Индекс нового элемента выделяется атомарным
+// fetch_add, а элементы хранятся в сегментах ёмкостью FIRST_SEGMENT_SIZE, 2 * FIRST_SEGMENT_SIZE, 4 * ...,
+// которые выделяются по мере надобности и публикуются через CAS в таблице фиксированного размера:
+// рост никогда не перемещает опубликованные элементы. Элемент становится видимым читателям после
+// завершения его конструктора; проверка и чтение опубликованного элемента выполняются без ожидания.
+// Если конструктор элемента выбросил исключение, его индекс навсегда остаётся неопубликованным.
+// Очистка и разрушение вектора не потокобезопасны
+template <typename T, typename Allocator = std::allocator<T>>
+class ConcurrentVector {
+    struct Slot {
+        T* Get() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+
+        std::atomic<bool> ready{false};
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using SlotTraits = std::allocator_traits<SlotAllocator>;
+
+    static constexpr size_t FIRST_SEGMENT_SHIFT = 5;
+    static constexpr size_t MAX_SEGMENTS = std::numeric_limits<size_t>::digits - FIRST_SEGMENT_SHIFT;
+
+public:
+    using allocator_type = Allocator;
+
+    static constexpr size_t FIRST_SEGMENT_SIZE = size_t{1} << FIRST_SEGMENT_SHIFT;
+
+    ConcurrentVector() = default;
+
+    explicit ConcurrentVector(const Allocator& alloc) noexcept
+            : alloc_(alloc) {
+    }
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    // Количество выделенных индексов, включая элементы, которые ещё создаются
+    size_t Size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    // Выделяет count подряд идущих индексов одной атомарной операцией и возвращает первый из них.
+    // Элементы по этим индексам создаёт вызывающий через EmplaceAt
+    size_t ReserveSlots(size_t count) noexcept {
+        return size_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    // Создаёт элемент по индексу, выделенному ReserveSlots, и публикует его
+    template <typename... Args>
+    T& EmplaceAt(size_t index, Args&&... args) {
+        assert(index < Size());
+        Slot& slot = SlotAt(index, AcquireSegment(SegmentOf(index)));
+        assert(!slot.ready.load(std::memory_order_relaxed));
+        T* value = new (slot.storage) T(std::forward<Args>(args)...);
+        slot.ready.store(true, std::memory_order_release);
+        return *value;
+    }
+
+    // Добавляет элемент и возвращает его индекс
+    template <typename... Args>
+    size_t EmplaceBack(Args&&... args) {
+        const size_t index = ReserveSlots(1);
+        EmplaceAt(index, std::forward<Args>(args)...);
+        return index;
+    }
+
+    size_t PushBack(const T& value) {
+        return EmplaceBack(value);
+    }
+
+    size_t PushBack(T&& value) {
+        return EmplaceBack(std::move(value));
+    }
+
+    // Элемент по индексу опубликован и может быть прочитан
+    bool IsCommitted(size_t index) const noexcept {
+        return TryGet(index) != nullptr;
+    }
+
+    // Опубликованный элемент либо nullptr, если элемент по индексу ещё не создан
+    const T* TryGet(size_t index) const noexcept {
+        if (index >= Size()) {
+            return nullptr;
+        }
+        Slot* segment = segments_[SegmentOf(index)].load(std::memory_order_acquire);
+        if (segment == nullptr) {
+            return nullptr;
+        }
+        Slot& slot = SlotAt(index, segment);
+        return slot.ready.load(std::memory_order_acquire) ? slot.Get() : nullptr;
+    }
+
+    T* TryGet(size_t index) noexcept {
+        return const_cast<T*>(std::as_const(*this).TryGet(index));
+    }
+
+    // Доступ к опубликованному элементу
+    const T& operator[](size_t index) const noexcept {
+        const T* value = TryGet(index);
+        assert(value != nullptr);
+        return *value;
+    }
+
+    T& operator[](size_t index) noexcept {
+        return const_cast<T&>(std::as_const(*this)[index]);
+    }
+
+    // Уничтожает все элементы, сохраняя сегменты. Нельзя вызывать одновременно с другими операциями
+    void Clear() noexcept {
+        const size_t size = size_.load(std::memory_order_relaxed);
+        for (size_t k = 0; k != MAX_SEGMENTS && SegmentBase(k) < size; ++k) {
+            Slot* segment = segments_[k].load(std::memory_order_relaxed);
+            if (segment == nullptr) {
+                continue;
+            }
+            for (size_t i = 0, count = std::min(SegmentSize(k), size - SegmentBase(k)); i != count; ++i) {
+                if (segment[i].ready.load(std::memory_order_relaxed)) {
+                    std::destroy_at(segment[i].Get());
+                    segment[i].ready.store(false, std::memory_order_relaxed);
+                }
+            }
+        }
+        size_.store(0, std::memory_order_relaxed);
+    }
+
+    ~ConcurrentVector() {
+        Clear();
+        for (size_t k = 0; k != MAX_SEGMENTS; ++k) {
+            if (Slot* segment = segments_[k].load(std::memory_order_relaxed)) {
+                FreeSegment(segment, k);
+            }
+        }
+    }
+
+private:
+    static size_t SegmentOf(size_t index) noexcept {
+        return detail::FloorLog2(index + FIRST_SEGMENT_SIZE) - FIRST_SEGMENT_SHIFT;
+    }
+
+    static size_t SegmentSize(size_t k) noexcept {
+        return FIRST_SEGMENT_SIZE << k;
+    }
+
+    // Индекс первого элемента сегмента k
+    static size_t SegmentBase(size_t k) noexcept {
+        return SegmentSize(k) - FIRST_SEGMENT_SIZE;
+    }
+
+    static Slot& SlotAt(size_t index, Slot* segment) noexcept {
+        return segment[index - SegmentBase(SegmentOf(index))];
+    }
+
+    // Возвращает сегмент k, выделяя его при первом обращении. Если несколько потоков выделили
+    // сегмент одновременно, публикуется первый, а остальные освобождаются
+    Slot* AcquireSegment(size_t k) {
+        Slot* segment = segments_[k].load(std::memory_order_acquire);
+        if (segment != nullptr) {
+            return segment;
+        }
+        SlotAllocator alloc(alloc_);
+        Slot* fresh = SlotTraits::allocate(alloc, SegmentSize(k));
+        std::uninitialized_default_construct_n(fresh, SegmentSize(k));
+        if (segments_[k].compare_exchange_strong(segment, fresh, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+            return fresh;
+        }
+        FreeSegment(fresh, k);
+        return segment;
+    }
+
+    void FreeSegment(Slot* segment, size_t k) noexcept {
+        SlotAllocator alloc(alloc_);
+        std::destroy_n(segment, SegmentSize(k));
+        SlotTraits::deallocate(alloc, segment, SegmentSize(k));
+    }
+
+    [[no_unique_address]] Allocator alloc_;
+    std::atomic<size_t> size_{0};
+    std::atomic<Slot*> segments_[MAX_SEGMENTS] = {};
+};
@@ -0,0 +1,441 @@
+#pragma once
+#include "vector.h"
+
+#include <functional>
+
+namespace detail {
+
+// Первый элемент отсортированного массива first[0..n), не меньший key. Цикл не содержит
+// непредсказуемых переходов: число шагов зависит только от n, а выбор половины выполняется
+// условной пересылкой, поэтому процессор не сбрасывает конвейер на каждом втором сравнении
+// и может заранее начать загрузку следующей точки деления
+template <typename T, typename Key, typename Compare>
+const T* BranchlessLowerBound(const T* first, size_t n, const Key& key, const Compare& comp) {
+    if (n == 0) {
+        return first;
+    }
+    const T* base = first;
+    while (n > 1) {
+        const size_t half = n / 2;
+        base = comp(base[half], key) ? base + half : base;
+        n -= half;
+    }
+    return base + static_cast<size_t>(comp(*base, key));
+}
+
+// Источник очередного элемента при слиянии имеющихся элементов с новыми
+enum class MergeStep : unsigned char {
+    EXISTING,   // берётся имеющийся элемент
+    ADDED,      // берётся новый элемент
+    DUPLICATE,  // берётся имеющийся элемент, а равный ему новый пропускается
+};
+
+// Порядок слияния отсортированных массивов из existing_size и added_size ключей (второй — без повторов),
+// которые возвращают existing_key(i) и added_key(j). Вычисляется одними сравнениями до переноса
+// элементов, поэтому исключение из компаратора не затрагивает ни один из массивов
+template <typename ExistingKey, typename AddedKey, typename Compare>
+Vector<MergeStep> MergeOrder(size_t existing_size, ExistingKey existing_key, size_t added_size, AddedKey added_key,
+                             const Compare& comp) {
+    Vector<MergeStep> steps;
+    steps.Reserve(existing_size + added_size);
+    size_t i = 0;
+    size_t j = 0;
+    while (i != existing_size || j != added_size) {
+        if (j == added_size || (i != existing_size && !comp(added_key(j), existing_key(i)))) {
+            const bool duplicate = j != added_size && !comp(existing_key(i), added_key(j));
+            steps.UncheckedEmplaceBack(duplicate ? MergeStep::DUPLICATE : MergeStep::EXISTING);
+            j += duplicate;
+            ++i;
+        } else {
+            steps.UncheckedEmplaceBack(MergeStep::ADDED);
+            ++j;
+        }
+    }
+    return steps;
+}
+
+}  // namespace detail
+
+// Множество уникальных ключей, хранящихся по возрастанию в одном Vector. Поиск выполняется двоичным
+// поиском по непрерывному массиву, обход — линейно по памяти. Вставка и удаление одиночного ключа
+// сдвигают хвост за O(n), поэтому множество эффективно, когда поисков намного больше, чем изменений,
+// а крупные изменения выполняются пакетно через конструктор из диапазона или InsertRange
+template <typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>>
+class FlatSet {
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using const_iterator = const Key*;
+    using iterator = const_iterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp, const Allocator& alloc = Allocator())
+            : keys_(alloc)
+            , comp_(comp) {
+    }
+
+    // Строит множество из неупорядоченного диапазона одной сортировкой с удалением повторов
+    template <typename InputIterator, detail::RequireInputIterator<InputIterator> = 0>
+    FlatSet(InputIterator first, InputIterator last, const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+            : keys_(first, last, alloc)
+            , comp_(comp) {
+        SortUnique();
+    }
+
+    // Добавляет ключи диапазона: новые ключи сортируются отдельно и сливаются с имеющимися в новый буфер.
+    // Имеющиеся ключи перемещаются, только если перемещение не выбрасывает исключений, иначе копируются,
+    // поэтому при исключении множество не изменяется
+    template <typename InputIterator, detail::RequireInputIterator<InputIterator> = 0>
+    void InsertRange(InputIterator first, InputIterator last) {
+        Vector<Key, Allocator> added(first, last, keys_.GetAllocator());
+        const auto equivalent = [this](const Key& lhs, const Key& rhs) {
+            return !comp_(lhs, rhs) && !comp_(rhs, lhs);
+        };
+        std::sort(added.begin(), added.end(), comp_);
+        added.Erase(std::unique(added.begin(), added.end(), equivalent), added.end());
+
+        const Vector<detail::MergeStep> steps = detail::MergeOrder(
+                keys_.Size(), [this](size_t i) -> const Key& { return keys_[i]; },
+                added.Size(), [&added](size_t j) -> const Key& { return added[j]; }, comp_);
+        Vector<Key, Allocator> keys(keys_.GetAllocator());
+        keys.Reserve(steps.Size());
+        size_t i = 0;
+        size_t j = 0;
+        for (const detail::MergeStep step : steps) {
+            if (step == detail::MergeStep::ADDED) {
+                keys.UncheckedEmplaceBack(std::move(added[j++]));
+            } else {
+                keys.UncheckedEmplaceBack(std::move_if_noexcept(keys_[i++]));
+                j += step == detail::MergeStep::DUPLICATE;
+            }
+        }
+        keys_.Swap(keys);
+    }
+
+    // Возвращает позицию ключа и признак того, что он был добавлен
+    std::pair<const_iterator, bool> Insert(const Key& key) {
+        return Emplace(key);
+    }
+
+    std::pair<const_iterator, bool> Insert(Key&& key) {
+        return Emplace(std::move(key));
+    }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> Emplace(Args&&... args) {
+        Key key(std::forward<Args>(args)...);
+        const_iterator pos = LowerBound(key);
+        if (pos != end() && !comp_(key, *pos)) {
+            return {pos, false};
+        }
+        return {keys_.Insert(pos, std::move(key)), true};
+    }
+
+    // Удаляет ключ и возвращает количество удалённых ключей (0 или 1)
+    size_t Erase(const Key& key) {
+        const const_iterator pos = Find(key);
+        if (pos == end()) {
+            return 0;
+        }
+        keys_.Erase(pos);
+        return 1;
+    }
+
+    const_iterator Erase(const_iterator pos) {
+        return keys_.Erase(pos);
+    }
+
+    const_iterator Erase(const_iterator first, const_iterator last) {
+        return keys_.Erase(first, last);
+    }
+
+    template <typename Predicate>
+    friend size_t EraseIf(FlatSet& set, Predicate pred) {
+        return EraseIf(set.keys_, pred);
+    }
+
+    const_iterator LowerBound(const Key& key) const {
+        return detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, comp_);
+    }
+
+    const_iterator UpperBound(const Key& key) const {
+        const auto greater = [this](const Key& element, const Key& k) {
+            return !comp_(k, element);
+        };
+        return detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, greater);
+    }
+
+    const_iterator Find(const Key& key) const {
+        const const_iterator pos = LowerBound(key);
+        return pos != end() && !comp_(key, *pos) ? pos : end();
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != end();
+    }
+
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return keys_.Empty();
+    }
+
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+    }
+
+    // Ключи по возрастанию
+    const Vector<Key, Allocator>& Keys() const noexcept {
+        return keys_;
+    }
+
+    const_iterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return keys_.end();
+    }
+
+    friend bool operator==(const FlatSet& lhs, const FlatSet& rhs) {
+        return lhs.keys_ == rhs.keys_;
+    }
+
+    friend bool operator!=(const FlatSet& lhs, const FlatSet& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Упорядочивает все ключи и удаляет повторы: используется при построении из неупорядоченного диапазона
+    void SortUnique() {
+        const auto equivalent = [this](const Key& lhs, const Key& rhs) {
+            return !comp_(lhs, rhs) && !comp_(rhs, lhs);
+        };
+        std::sort(keys_.begin(), keys_.end(), comp_);
+        keys_.Erase(std::unique(keys_.begin(), keys_.end(), equivalent), keys_.end());
+    }
+
+    Vector<Key, Allocator> keys_;
+    [[no_unique_address]] Compare comp_;
+};
+
+// Ассоциативный массив с уникальными ключами, хранящий ключи и значения в двух параллельных Vector.
+// Двоичный поиск читает только массив ключей, поэтому в кэш не попадают значения, а обход значений
+// идёт линейно по памяти. Как и FlatSet, рассчитан на преобладание поисков над изменениями
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename KeyAllocator = std::allocator<Key>, typename ValueAllocator = std::allocator<Value>>
+class FlatMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using key_compare = Compare;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp)
+            : comp_(comp) {
+    }
+
+    // Строит отображение из неупорядоченного диапазона пар ключ-значение одной устойчивой сортировкой.
+    // Из пар с равными ключами, как и при вставке в std::map, остаётся первая
+    template <typename InputIterator, detail::RequireInputIterator<InputIterator> = 0>
+    FlatMap(InputIterator first, InputIterator last, const Compare& comp = Compare())
+            : comp_(comp) {
+        InsertRange(first, last);
+    }
+
+    // Добавляет пары диапазона, ключей которых ещё нет. Существующие значения не изменяются.
+    // Новые пары сортируются отдельно и сливаются с имеющимися в новые буферы. Имеющиеся пары
+    // перемещаются, только если перемещение и ключа, и значения не выбрасывает исключений, иначе
+    // копируются, поэтому при исключении отображение не изменяется
+    template <typename InputIterator, detail::RequireInputIterator<InputIterator> = 0>
+    void InsertRange(InputIterator first, InputIterator last) {
+        using Pair = std::pair<Key, Value>;
+        Vector<Pair> pairs(first, last);
+        const auto by_key = [this](const Pair& lhs, const Pair& rhs) {
+            return comp_(lhs.first, rhs.first);
+        };
+        std::stable_sort(pairs.begin(), pairs.end(), by_key);
+        pairs.Erase(std::unique(pairs.begin(), pairs.end(),
+                                [&by_key](const Pair& lhs, const Pair& rhs) {
+                                    return !by_key(lhs, rhs) && !by_key(rhs, lhs);
+                                }),
+                    pairs.end());
+
+        const Vector<detail::MergeStep> steps = detail::MergeOrder(
+                keys_.Size(), [this](size_t i) -> const Key& { return keys_[i]; },
+                pairs.Size(), [&pairs](size_t j) -> const Key& { return pairs[j].first; }, comp_);
+        constexpr bool MOVE_EXISTING =
+                std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<Value>;
+        Vector<Key, KeyAllocator> keys(keys_.GetAllocator());
+        Vector<Value, ValueAllocator> values(values_.GetAllocator());
+        keys.Reserve(steps.Size());
+        values.Reserve(steps.Size());
+        size_t i = 0;
+        size_t j = 0;
+        for (const detail::MergeStep step : steps) {
+            if (step == detail::MergeStep::ADDED) {
+                keys.UncheckedEmplaceBack(std::move(pairs[j].first));
+                values.UncheckedEmplaceBack(std::move(pairs[j].second));
+                ++j;
+                continue;
+            }
+            if constexpr (MOVE_EXISTING) {
+                keys.UncheckedEmplaceBack(std::move(keys_[i]));
+                values.UncheckedEmplaceBack(std::move(values_[i]));
+            } else {
+                keys.UncheckedEmplaceBack(std::as_const(keys_[i]));
+                values.UncheckedEmplaceBack(std::as_const(values_[i]));
+            }
+            ++i;
+            j += step == detail::MergeStep::DUPLICATE;
+        }
+        keys_.Swap(keys);
+        values_.Swap(values);
+    }
+
+    // Добавляет значение, созданное из args, если ключа ещё нет. Возвращает значение по ключу
+    // и признак того, что оно было добавлено
+    template <typename... Args>
+    std::pair<Value*, bool> TryEmplace(const Key& key, Args&&... args) {
+        const size_t index = LowerBoundIndex(key);
+        if (index != keys_.Size() && !comp_(key, keys_[index])) {
+            return {&values_[index], false};
+        }
+        keys_.Insert(keys_.begin() + index, key);
+        try {
+            values_.Emplace(values_.begin() + index, std::forward<Args>(args)...);
+        } catch (...) {
+            keys_.Erase(keys_.begin() + index);
+            throw;
+        }
+        return {&values_[index], true};
+    }
+
+    std::pair<Value*, bool> Insert(const Key& key, const Value& value) {
+        return TryEmplace(key, value);
+    }
+
+    std::pair<Value*, bool> Insert(const Key& key, Value&& value) {
+        return TryEmplace(key, std::move(value));
+    }
+
+    // Присваивает значение существующему ключу или добавляет новую пару
+    template <typename V>
+    Value& InsertOrAssign(const Key& key, V&& value) {
+        auto [ptr, inserted] = TryEmplace(key, std::forward<V>(value));
+        if (!inserted) {
+            *ptr = std::forward<V>(value);
+        }
+        return *ptr;
+    }
+
+    // Значение по ключу; отсутствующий ключ добавляется со значением, инициализированным по умолчанию
+    Value& operator[](const Key& key) {
+        return *TryEmplace(key).first;
+    }
+
+    Value& At(const Key& key) {
+        if (Value* value = Find(key)) {
+            return *value;
+        }
+        throw std::out_of_range("FlatMap::At: key not found");
+    }
+
+    const Value& At(const Key& key) const {
+        return const_cast<FlatMap&>(*this).At(key);
+    }
+
+    // Значение по ключу либо nullptr, если ключа нет
+    Value* Find(const Key& key) {
+        const size_t index = LowerBoundIndex(key);
+        return index != keys_.Size() && !comp_(key, keys_[index]) ? &values_[index] : nullptr;
+    }
+
+    const Value* Find(const Key& key) const {
+        return const_cast<FlatMap&>(*this).Find(key);
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != nullptr;
+    }
+
+    size_t Erase(const Key& key) {
+        const size_t index = LowerBoundIndex(key);
+        if (index == keys_.Size() || comp_(key, keys_[index])) {
+            return 0;
+        }
+        keys_.Erase(keys_.begin() + index);
+        values_.Erase(values_.begin() + index);
+        return 1;
+    }
+
+    // Позиция первого ключа, не меньшего key
+    size_t LowerBoundIndex(const Key& key) const {
+        return detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, comp_) - keys_.Data();
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return keys_.Empty();
+    }
+
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+        values_.Reserve(capacity);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    // Ключи по возрастанию и соответствующие им значения
+    const Vector<Key, KeyAllocator>& Keys() const noexcept {
+        return keys_;
+    }
+
+    const Vector<Value, ValueAllocator>& Values() const noexcept {
+        return values_;
+    }
+
+    Vector<Value, ValueAllocator>& Values() noexcept {
+        return values_;
+    }
+
+    // Вызывает func(key, value) для пар по возрастанию ключей
+    template <typename Func>
+    void ForEach(Func&& func) {
+        for (size_t i = 0; i != keys_.Size(); ++i) {
+            func(std::as_const(keys_[i]), values_[i]);
+        }
+    }
+
+    template <typename Func>
+    void ForEach(Func&& func) const {
+        for (size_t i = 0; i != keys_.Size(); ++i) {
+            func(keys_[i], values_[i]);
+        }
+    }
+
+private:
+    Vector<Key, KeyAllocator> keys_;
+    Vector<Value, ValueAllocator> values_;
+    [[no_unique_address]] Compare comp_;
+};
@@ -0,0 +1,146 @@
+#pragma once
+#include "vector.h"
+
+// Передача буферов между вектором и внешним кодом без копирования элементов
+
+// Аллокатор, который помимо собственной памяти базового аллокатора Base владеет одним внешним буфером,
+// полученным, например, от библиотеки распаковки или кольца ввода-вывода. Внешний буфер освобождается
+// функцией deleter(data, capacity, context), когда контейнер освобождает его при росте или разрушении.
+// Сведения о внешнем буфере хранятся в общем блоке, разделяемом копиями аллокатора: контейнер создаёт
+// новый буфер через копию аллокатора и обменивается с ним, и после освобождения внешнего буфера
+// ни одна копия не должна принимать за него совпавший адрес из базового аллокатора.
+// Копия контейнера получает аллокатор без внешнего буфера
+template <typename T, typename Base = std::allocator<T>>
+class ForeignBufferAllocator {
+    using BaseTraits = std::allocator_traits<Base>;
+
+public:
+    using value_type = T;
+    using Deleter = void (*)(T* data, size_t capacity, void* context) noexcept;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = ForeignBufferAllocator<U, typename BaseTraits::template rebind_alloc<U>>;
+    };
+
+    ForeignBufferAllocator() = default;
+
+    explicit ForeignBufferAllocator(const Base& base) noexcept
+            : base_(base) {
+    }
+
+    // Выделяет общий блок; если выделение выбрасывает исключение, буфер остаётся у вызывающего
+    ForeignBufferAllocator(T* buffer, Deleter deleter, void* context = nullptr, const Base& base = Base())
+            : base_(base)
+            , foreign_(std::make_shared<Foreign>(Foreign{buffer, deleter, context})) {
+    }
+
+    // Внешний буфер хранит элементы типа T, поэтому при смене типа он не переносится
+    template <typename U, typename OtherBase>
+    ForeignBufferAllocator(const ForeignBufferAllocator<U, OtherBase>& other) noexcept
+            : base_(other.base_) {
+    }
+
+    T* allocate(size_t n) {
+        return BaseTraits::allocate(base_, n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (p != nullptr && foreign_ && p == foreign_->buffer) {
+            foreign_->buffer = nullptr;
+            foreign_->deleter(p, n, foreign_->context);
+        } else {
+            BaseTraits::deallocate(base_, p, n);
+        }
+    }
+
+    ForeignBufferAllocator select_on_container_copy_construction() const {
+        return ForeignBufferAllocator(BaseTraits::select_on_container_copy_construction(base_));
+    }
+
+    // Внешний буфер, ещё не возвращённый функции deleter
+    T* ForeignBuffer() const noexcept {
+        return foreign_ ? foreign_->buffer : nullptr;
+    }
+
+    // Копии, разделяющие общий блок, равны: каждая может освободить внешний буфер
+    template <typename U, typename OtherBase>
+    bool operator==(const ForeignBufferAllocator<U, OtherBase>& other) const noexcept {
+        return base_ == other.base_ && static_cast<const void*>(foreign_.get()) == other.foreign_.get();
+    }
+
+    template <typename U, typename OtherBase>
+    bool operator!=(const ForeignBufferAllocator<U, OtherBase>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    template <typename U, typename OtherBase>
+    friend class ForeignBufferAllocator;
+
+    struct Foreign {
+        T* buffer;
+        Deleter deleter;
+        void* context;
+    };
+
+    [[no_unique_address]] Base base_;
+    std::shared_ptr<Foreign> foreign_;
+};
+
+// Создаёт вектор над внешним буфером data ёмкостью capacity, в начале которого находятся size элементов
+// (для тривиально копируемых T — просто заполненные байты). Элементы не копируются; буфер освобождается
+// вызовом deleter(data, capacity, context), когда вектору понадобится больший буфер или при его разрушении.
+// Если не удалось выделить общий блок аллокатора, выбрасывается std::bad_alloc и буфер остаётся у вызывающего
+template <typename T, typename GrowthPolicy = DoublingGrowth>
+Vector<T, ForeignBufferAllocator<T>, GrowthPolicy> AdoptForeignBuffer(
+        T* data, size_t size, size_t capacity, typename ForeignBufferAllocator<T>::Deleter deleter,
+        void* context = nullptr) {
+    Vector<T, ForeignBufferAllocator<T>, GrowthPolicy> v(ForeignBufferAllocator<T>(data, deleter, context));
+    v.AdoptBuffer({data, size, capacity});
+    return v;
+}
+
+// Удалитель буфера, отданного вектором функцией ReleaseOwned: уничтожает элементы
+// и возвращает память аллокатору вектора
+template <typename T, typename Allocator>
+class BufferDeleter {
+public:
+    BufferDeleter() = default;
+
+    BufferDeleter(const Allocator& alloc, size_t size, size_t capacity) noexcept
+            : alloc_(alloc)
+            , size_(size)
+            , capacity_(capacity) {
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    void operator()(T* data) noexcept {
+        std::destroy_n(data, size_);
+        std::allocator_traits<Allocator>::deallocate(alloc_, data, capacity_);
+    }
+
+private:
+    [[no_unique_address]] Allocator alloc_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+// Отдаёт буфер вектора внешнему коду, оставляя вектор пустым. Количество элементов доступно через
+// get_deleter().Size(), а элементы уничтожаются и память освобождается вместе с указателем
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename BoundsCheck>
+std::unique_ptr<T[], BufferDeleter<T, Allocator>> ReleaseOwned(Vector<T, Allocator, GrowthPolicy, StatsPolicy, BoundsCheck>& v) noexcept {
+    const auto buffer = v.ReleaseBuffer();
+    return {buffer.data, BufferDeleter<T, Allocator>(v.GetAllocator(), buffer.size, buffer.capacity)};
+}
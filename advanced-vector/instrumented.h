@@ -0,0 +1,297 @@
+#pragma once
+#include "vector.h"
+
+#include <chrono>
+#include <cstdio>
+
+// Инструменты для тестов и бенчмарков, проверяющие не только результат операций контейнера,
+// но и их стоимость: сколько элементов было создано, скопировано, перемещено и уничтожено
+// и сколько памяти было выделено. Элементы Instrumented<Tag> и аллокаторы CountingAllocator<T, Tag>
+// с одним тегом Tag ведут общие счётчики, а OperationProbe<Tag> измеряет их приращение на участке кода:
+//     OperationProbe<MyTag> probe;
+//     v.PushBack(value);
+//     assert(probe.Exactly(OperationBudget().Copies(1).Moves(n).Allocations(1)));
+// Счётчики не атомарны и рассчитаны на однопоточные измерения
+
+// Количество операций над элементами и выделений памяти
+struct OperationCounts {
+    size_t constructed = 0;  // созданные конструкторами, кроме копирующего и перемещающего
+    size_t copied = 0;
+    size_t moved = 0;
+    size_t copy_assigned = 0;
+    size_t move_assigned = 0;
+    size_t destroyed = 0;
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t allocated_bytes = 0;
+
+    size_t Assigned() const noexcept {
+        return copy_assigned + move_assigned;
+    }
+
+    // Разность живых объектов: созданные минус уничтоженные
+    std::ptrdiff_t Alive() const noexcept {
+        return static_cast<std::ptrdiff_t>(constructed + copied + moved) - static_cast<std::ptrdiff_t>(destroyed);
+    }
+
+    OperationCounts operator-(const OperationCounts& rhs) const noexcept {
+        return {constructed - rhs.constructed,     copied - rhs.copied,
+                moved - rhs.moved,                 copy_assigned - rhs.copy_assigned,
+                move_assigned - rhs.move_assigned, destroyed - rhs.destroyed,
+                allocations - rhs.allocations,     deallocations - rhs.deallocations,
+                allocated_bytes - rhs.allocated_bytes};
+    }
+};
+
+namespace detail {
+
+template <typename Tag>
+struct InstrumentationCounters {
+    static inline OperationCounts counts;
+    // Номер следующего создания копированием или конструктором, которое выбросит исключение; 0 — никогда
+    static inline size_t throw_countdown = 0;
+};
+
+}  // namespace detail
+
+// Бюджет операций: ограничения на отдельные счётчики. Неуказанные счётчики не ограничены
+class OperationBudget {
+public:
+    static constexpr size_t ANY = std::numeric_limits<size_t>::max();
+
+    OperationBudget& Constructions(size_t n) noexcept {
+        constructed_ = n;
+        return *this;
+    }
+
+    OperationBudget& Copies(size_t n) noexcept {
+        copied_ = n;
+        return *this;
+    }
+
+    OperationBudget& Moves(size_t n) noexcept {
+        moved_ = n;
+        return *this;
+    }
+
+    OperationBudget& Assignments(size_t n) noexcept {
+        assigned_ = n;
+        return *this;
+    }
+
+    OperationBudget& Destructions(size_t n) noexcept {
+        destroyed_ = n;
+        return *this;
+    }
+
+    OperationBudget& Allocations(size_t n) noexcept {
+        allocations_ = n;
+        return *this;
+    }
+
+    OperationBudget& AllocatedBytes(size_t n) noexcept {
+        allocated_bytes_ = n;
+        return *this;
+    }
+
+    // Проверяет счётчики: exact — на равенство ограничениям, иначе — на непревышение.
+    // Нарушения выводятся в stderr с пометкой what
+    bool Check(const OperationCounts& counts, bool exact, const char* what) const {
+        bool ok = true;
+        const auto check = [&](const char* name, size_t actual, size_t limit) {
+            if (limit != ANY && (exact ? actual != limit : actual > limit)) {
+                std::fprintf(stderr, "%s: %zu %s, expected %s %zu\n", what, actual, name, exact ? "exactly" : "at most",
+                             limit);
+                ok = false;
+            }
+        };
+        check("constructions", counts.constructed, constructed_);
+        check("copies", counts.copied, copied_);
+        check("moves", counts.moved, moved_);
+        check("assignments", counts.Assigned(), assigned_);
+        check("destructions", counts.destroyed, destroyed_);
+        check("allocations", counts.allocations, allocations_);
+        check("allocated bytes", counts.allocated_bytes, allocated_bytes_);
+        return ok;
+    }
+
+private:
+    size_t constructed_ = ANY;
+    size_t copied_ = ANY;
+    size_t moved_ = ANY;
+    size_t assigned_ = ANY;
+    size_t destroyed_ = ANY;
+    size_t allocations_ = ANY;
+    size_t allocated_bytes_ = ANY;
+};
+
+// Элемент, подсчитывающий свои операции. NothrowMove определяет, объявлено ли перемещение noexcept
+// (иначе контейнеры при переносе копируют элементы), Relocatable включает тривиальную релоцируемость
+// (перенос побайтовым копированием, не видимый счётчикам)
+template <typename Tag = void, bool NothrowMove = true, bool Relocatable = false>
+class Instrumented {
+    using Counters = detail::InstrumentationCounters<Tag>;
+
+public:
+    Instrumented() {
+        OnConstruct();
+        ++Counters::counts.constructed;
+    }
+
+    explicit Instrumented(int value)
+            : value_(value) {
+        OnConstruct();
+        ++Counters::counts.constructed;
+    }
+
+    Instrumented(const Instrumented& other)
+            : value_(other.value_) {
+        OnConstruct();
+        ++Counters::counts.copied;
+    }
+
+    Instrumented(Instrumented&& other) noexcept(NothrowMove)
+            : value_(std::exchange(other.value_, 0)) {
+        ++Counters::counts.moved;
+    }
+
+    Instrumented& operator=(const Instrumented& rhs) {
+        value_ = rhs.value_;
+        ++Counters::counts.copy_assigned;
+        return *this;
+    }
+
+    Instrumented& operator=(Instrumented&& rhs) noexcept(NothrowMove) {
+        value_ = std::exchange(rhs.value_, 0);
+        ++Counters::counts.move_assigned;
+        return *this;
+    }
+
+    ~Instrumented() {
+        ++Counters::counts.destroyed;
+    }
+
+    int Value() const noexcept {
+        return value_;
+    }
+
+    static const OperationCounts& Counts() noexcept {
+        return Counters::counts;
+    }
+
+    // Обнуляет счётчики тега и отключает выбрасывание исключений
+    static void Reset() noexcept {
+        Counters::counts = {};
+        Counters::throw_countdown = 0;
+    }
+
+    // n-е следующее создание элемента конструктором или копированием выбросит std::runtime_error
+    static void ThrowOnConstruction(size_t n) noexcept {
+        Counters::throw_countdown = n;
+    }
+
+    friend bool operator==(const Instrumented& lhs, const Instrumented& rhs) noexcept {
+        return lhs.value_ == rhs.value_;
+    }
+
+    friend bool operator!=(const Instrumented& lhs, const Instrumented& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const Instrumented& lhs, const Instrumented& rhs) noexcept {
+        return lhs.value_ < rhs.value_;
+    }
+
+private:
+    static void OnConstruct() {
+        if (Counters::throw_countdown != 0 && --Counters::throw_countdown == 0) {
+            throw std::runtime_error("instrumented construction failure");
+        }
+    }
+
+    int value_ = 0;
+};
+
+template <typename Tag, bool NothrowMove>
+struct IsTriviallyRelocatable<Instrumented<Tag, NothrowMove, true>> : std::true_type {};
+
+// Аллокатор поверх std::allocator, подсчитывающий выделения и их объём в счётчиках тега Tag
+template <typename T, typename Tag = void>
+class CountingAllocator {
+    using Counters = detail::InstrumentationCounters<Tag>;
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = CountingAllocator<U, Tag>;
+    };
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U, Tag>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        T* p = std::allocator<T>().allocate(n);
+        ++Counters::counts.allocations;
+        Counters::counts.allocated_bytes += n * sizeof(T);
+        return p;
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        std::allocator<T>().deallocate(p, n);
+        ++Counters::counts.deallocations;
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U, Tag>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const CountingAllocator<U, Tag>&) const noexcept {
+        return false;
+    }
+};
+
+// Измеряет приращение счётчиков тега Tag и время, прошедшее с момента создания или вызова Restart
+template <typename Tag = void>
+class OperationProbe {
+    using Clock = std::chrono::steady_clock;
+
+public:
+    OperationProbe() noexcept {
+        Restart();
+    }
+
+    void Restart() noexcept {
+        start_counts_ = detail::InstrumentationCounters<Tag>::counts;
+        start_time_ = Clock::now();
+    }
+
+    OperationCounts Counts() const noexcept {
+        return detail::InstrumentationCounters<Tag>::counts - start_counts_;
+    }
+
+    std::chrono::nanoseconds Elapsed() const noexcept {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_time_);
+    }
+
+    // Операций не больше, чем разрешает бюджет
+    bool Within(const OperationBudget& budget, const char* what = "operation budget") const {
+        return budget.Check(Counts(), false, what);
+    }
+
+    // Операций ровно столько, сколько указано в бюджете
+    bool Exactly(const OperationBudget& budget, const char* what = "operation budget") const {
+        return budget.Check(Counts(), true, what);
+    }
+
+private:
+    OperationCounts start_counts_;
+    Clock::time_point start_time_;
+};
@@ -1,10 +1,33 @@
 #include "vector.h"
+#include "slot_vector.h"
+#include "small_vector.h"
+#include "mmap_allocator.h"
+#include "serialization.h"
+#include "foreign_buffer.h"
+#include "segmented_vector.h"
+#include "soa_vector.h"
+#include "concurrent_vector.h"
+#include "thread_local_appender.h"
+#include "flat_map.h"
+#include "pool_allocator.h"
+#include "instrumented.h"
 
+#include <array>
 #include <iostream>
+#include <map>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
 
 namespace {
 
@@ -117,8 +140,117 @@ struct Obj {
     static inline int num_move_assigned = 0;
 };
 
+// Владеющий дескриптор: не тривиально копируемый, но допускающий побайтовый перенос
+struct Handle {
+    explicit Handle(int value)
+            : value(new int(value))  //
+    {
+    }
+
+    Handle(Handle&& other) noexcept
+            : value(std::exchange(other.value, nullptr))  //
+    {
+        ++num_moved;
+    }
+
+    Handle& operator=(Handle&& other) noexcept {
+        std::swap(value, other.value);
+        ++num_move_assigned;
+        return *this;
+    }
+
+    ~Handle() {
+        delete value;
+        ++num_destroyed;
+    }
+
+    static void ResetCounters() {
+        num_moved = 0;
+        num_move_assigned = 0;
+        num_destroyed = 0;
+    }
+
+    int* value = nullptr;
+
+    static inline int num_moved = 0;
+    static inline int num_move_assigned = 0;
+    static inline int num_destroyed = 0;
+};
+
+// Ресурс памяти, подсчитывающий выделения и объём занятой памяти
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t bytes_in_use = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        bytes_in_use += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        bytes_in_use -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// Аллокатор, выделяющий блоки с запасом в SLAB_SIZE элементов и расширяющий их на месте
+template <typename T>
+struct SlabAllocator {
+    using value_type = T;
+
+    static constexpr size_t SLAB_SIZE = 1024;
+
+    SlabAllocator() = default;
+
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        assert(n <= SLAB_SIZE);
+        return static_cast<T*>(operator new(SLAB_SIZE * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t /*n*/) noexcept {
+        operator delete(p);
+    }
+
+    bool try_expand(T* /*p*/, size_t /*old_n*/, size_t new_n) noexcept {
+        return new_n <= SLAB_SIZE;
+    }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const SlabAllocator<U>& /*other*/) const noexcept {
+        return false;
+    }
+};
+
 }  // namespace
 
+template <>
+struct IsTriviallyRelocatable<Handle> : std::true_type {};
+
+// Элементы и вектор с общими счётчиками для проверки бюджетов операций в Test1-Test6
+struct BudgetTag {};
+using Counted = Instrumented<BudgetTag>;
+using CountedThrowingMove = Instrumented<BudgetTag, false>;
+using CountedRelocatable = Instrumented<BudgetTag, true, true>;
+template <typename T>
+using CountedVector = Vector<T, CountingAllocator<T, BudgetTag>>;
+using Budget = OperationBudget;
+
 void Test1() {
     Obj::ResetCounters();
     const size_t SIZE = 100500;
@@ -172,6 +304,27 @@ void Test1() {
         assert(Obj::num_moved == old_move_count + static_cast<int>(SIZE));
     }
     assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Перенос при Reserve: ровно SIZE перемещений, одно выделение и никаких копий
+        CountedVector<Counted> v(SIZE);
+        OperationProbe<BudgetTag> probe;
+        v.Reserve(SIZE * 2);
+        assert(probe.Exactly(Budget().Constructions(0).Copies(0).Moves(SIZE).Destructions(SIZE).Allocations(1),
+                             "Reserve"));
+        probe.Restart();
+        v.Reserve(SIZE);
+        assert(probe.Exactly(Budget().Moves(0).Destructions(0).Allocations(0), "Reserve below capacity"));
+    }
+    {
+        // Тривиально релоцируемые элементы переносятся побайтово
+        CountedVector<CountedRelocatable> v(SIZE);
+        OperationProbe<BudgetTag> probe;
+        v.Reserve(SIZE * 2);
+        assert(probe.Exactly(Budget().Copies(0).Moves(0).Destructions(0).Allocations(1).AllocatedBytes(
+                                     SIZE * 2 * sizeof(CountedRelocatable)),
+                             "relocating Reserve"));
+    }
+    assert(Counted::Counts().Alive() == 0);
 }
 
 void Test2() {
@@ -219,6 +372,30 @@ void Test2() {
         assert(v.Size() == SIZE);
         assert(Obj::GetAliveObjectCount() == SIZE);
     }
+    Counted::Reset();
+    {
+        // Без noexcept-перемещения Reserve копирует элементы
+        CountedVector<CountedThrowingMove> v(SIZE);
+        OperationProbe<BudgetTag> probe;
+        v.Reserve(SIZE * 2);
+        assert(probe.Exactly(Budget().Copies(SIZE).Moves(0).Destructions(SIZE).Allocations(1), "copying Reserve"));
+
+        // Исключение при копировании откатывает уже созданные копии и освобождает новый буфер
+        CountedThrowingMove::ThrowOnConstruction(SIZE / 2);
+        probe.Restart();
+        try {
+            v.Reserve(SIZE * 4);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(probe.Exactly(Budget().Copies(SIZE / 2 - 1).Moves(0).Destructions(SIZE / 2 - 1).Allocations(1),
+                             "failed Reserve"));
+        assert(probe.Counts().deallocations == 1);
+        assert(v.Capacity() == SIZE * 2);
+        assert(v.Size() == SIZE);
+    }
+    assert(Counted::Counts().Alive() == 0);
+    assert(Counted::Counts().allocations == Counted::Counts().deallocations);
 }
 
 void Test3() {
@@ -291,6 +468,28 @@ void Test3() {
         v_small[MEDIUM_SIZE - 1].id = ID;
         assert(Obj::num_copied - num_copies == MEDIUM_SIZE - (MEDIUM_SIZE / 2));
     }
+    {
+        Counted::Reset();
+        CountedVector<Counted> v(MEDIUM_SIZE);
+        OperationProbe<BudgetTag> probe;
+        CountedVector<Counted> v_copy(v);
+        assert(probe.Exactly(Budget().Copies(MEDIUM_SIZE).Moves(0).Assignments(0).Allocations(1), "copy"));
+
+        // Перемещение вектора не трогает элементы и не выделяет память
+        probe.Restart();
+        CountedVector<Counted> v_moved(std::move(v_copy));
+        assert(probe.Exactly(
+                Budget().Constructions(0).Copies(0).Moves(0).Assignments(0).Destructions(0).Allocations(0), "move"));
+
+        // Присваивание в вектор достаточной ёмкости обходится без выделений
+        CountedVector<Counted> v_large(LARGE_SIZE);
+        probe.Restart();
+        v_large = v;
+        assert(probe.Exactly(
+                Budget().Copies(0).Assignments(MEDIUM_SIZE).Destructions(LARGE_SIZE - MEDIUM_SIZE).Allocations(0),
+                "copy assignment"));
+    }
+    assert(Counted::Counts().Alive() == 0);
 }
 
 void Test4() {
@@ -370,6 +569,36 @@ void Test4() {
         assert(v[0].IsAlive());
         assert(v[1].IsAlive());
     }
+    Counted::Reset();
+    {
+        // PushBack в заполненный вектор: одна копия нового элемента, SIZE перемещений и одно выделение
+        CountedVector<Counted> v(SIZE);
+        const Counted value{int(ID)};
+        OperationProbe<BudgetTag> probe;
+        v.PushBack(value);
+        assert(probe.Exactly(Budget().Copies(1).Moves(SIZE).Destructions(SIZE).Allocations(1), "full PushBack"));
+
+        // При свободной ёмкости PushBack не переносит элементы
+        probe.Restart();
+        v.PushBack(Counted{int(ID)});
+        assert(probe.Exactly(Budget().Constructions(1).Copies(0).Moves(1).Destructions(1).Allocations(0),
+                             "PushBack with spare capacity"));
+    }
+    {
+        CountedVector<CountedRelocatable> v(SIZE);
+        OperationProbe<BudgetTag> probe;
+        v.PushBack(CountedRelocatable{int(ID)});
+        assert(probe.Exactly(Budget().Copies(0).Moves(1).Destructions(1).Allocations(1), "relocating PushBack"));
+    }
+    {
+        // Resize до меньшего размера только уничтожает лишние элементы
+        CountedVector<Counted> v(SIZE);
+        OperationProbe<BudgetTag> probe;
+        v.Resize(SIZE / 2);
+        assert(probe.Exactly(Budget().Constructions(0).Moves(0).Destructions(SIZE - SIZE / 2).Allocations(0),
+                             "shrinking Resize"));
+    }
+    assert(Counted::Counts().Alive() == 0);
 }
 
 void Test5() {
@@ -397,6 +626,24 @@ void Test5() {
         assert(v[0].IsAlive());
         assert(v[1].IsAlive());
     }
+    Counted::Reset();
+    {
+        // EmplaceBack создаёт элемент на месте без временных объектов
+        const size_t SIZE = 1000;
+        CountedVector<Counted> v;
+        v.Reserve(SIZE);
+        OperationProbe<BudgetTag> probe;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(ID);
+        }
+        assert(probe.Exactly(
+                Budget().Constructions(SIZE).Copies(0).Moves(0).Destructions(0).Allocations(0), "reserved EmplaceBack"));
+
+        probe.Restart();
+        v.EmplaceBack(ID);
+        assert(probe.Exactly(Budget().Constructions(1).Copies(0).Moves(SIZE).Allocations(1), "full EmplaceBack"));
+    }
+    assert(Counted::Counts().Alive() == 0);
 }
 
 void Test6() {
@@ -539,7 +786,7 @@ void Test6() {
         assert(Obj::num_default_constructed == SIZE);
         assert(Obj::num_constructed_with_id_and_name == 1);
         assert(Obj::num_moved == old_num_moved + 1);
-        assert(Obj::num_move_assigned == SIZE - 3);
+        assert(Obj::num_move_assigned == SIZE - 4);
         assert(Obj::num_assigned == 0);
     }
     {
@@ -557,87 +804,1706 @@ void Test6() {
         assert(Obj::num_moved == 0);
         assert(Obj::GetAliveObjectCount() == SIZE - 1);
     }
+    Counted::Reset();
+    {
+        // Вставка в середину без реаллокации: одно перемещение за конец, сдвиг присваиваниями, а новый
+        // элемент создаётся прямо на месте уничтоженного перемещённого, без временного объекта
+        CountedVector<Counted> v(SIZE);
+        v.Reserve(SIZE * 2);
+        OperationProbe<BudgetTag> probe;
+        v.Emplace(v.cbegin() + 3, ID);
+        assert(probe.Exactly(
+                Budget().Constructions(1).Copies(0).Moves(1).Assignments(SIZE - 4).Destructions(1).Allocations(0),
+                "Emplace"));
+        assert(v[3].Value() == ID && v[4].Value() == 0);
+
+        // Исключение конструктора возвращает хвост на место
+        v[4] = Counted(4);
+        Counted::ThrowOnConstruction(1);
+        try {
+            v.Emplace(v.cbegin() + 2, ID);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE + 1 && v[3].Value() == ID && v[4].Value() == 4);
+
+        // Удаление сдвигает хвост присваиваниями и уничтожает один элемент
+        probe.Restart();
+        v.Erase(v.cbegin() + 1);
+        assert(probe.Exactly(Budget().Copies(0).Moves(0).Assignments(SIZE - 1).Destructions(1).Allocations(0),
+                             "Erase"));
+        assert(v[2].Value() == ID && v[3].Value() == 4);
+    }
+    assert(Counted::Counts().Alive() == 0);
+    {
+        // Аргументы из сдвигаемых элементов читаются до сдвига
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        v[5].id = ID;
+        v[5].name = "Ivan"s;
+        v.Emplace(v.cbegin() + 1, v[5].id, v[5].name);
+        assert(v[1].id == ID && v[1].name == "Ivan"s && v[6].id == ID && v[6].name == "Ivan"s);
+    }
 }
 
-struct C {
-    C() noexcept {
-        ++def_ctor;
+void Test7() {
+    const size_t SIZE = 4;
+    {
+        Handle::ResetCounters();
+        Vector<Handle> v;
+        v.Reserve(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        v.Reserve(SIZE * 2);
+        assert(v.Capacity() == SIZE * 2);
+        assert(Handle::num_moved == 0);
+        assert(Handle::num_destroyed == 0);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(*v[i].value == static_cast<int>(i));
+        }
+
+        auto* pos = v.Emplace(v.cbegin() + 1, 42);
+        assert(*pos->value == 42);
+        assert(v.Size() == SIZE + 1);
+        assert(*v[2].value == 1);
+        assert(*v[SIZE].value == SIZE - 1);
+        assert(Handle::num_moved == 0);
+        assert(Handle::num_move_assigned == 0);
+        assert(Handle::num_destroyed == 0);
+
+        Handle::ResetCounters();
+        pos = v.Erase(v.cbegin() + 1);
+        assert(*pos->value == 1);
+        assert(v.Size() == SIZE);
+        assert(Handle::num_move_assigned == 0);
+        assert(Handle::num_destroyed == 1);
+
+        Handle::ResetCounters();
+    }
+    assert(Handle::num_destroyed == static_cast<int>(SIZE));
+    {
+        Vector<int> v;
+        for (int i = 0; i < 10; ++i) {
+            v.Insert(v.cbegin(), i);
+        }
+        v.Erase(v.cbegin() + 3);
+        const std::vector<int> expected{9, 8, 7, 5, 4, 3, 2, 1, 0};
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
     }
-    C(const C& /*other*/) noexcept {
-        ++copy_ctor;
+}
+
+void Test8() {
+    using PmrVector = Vector<std::string, std::pmr::polymorphic_allocator<std::string>>;
+    static_assert(sizeof(Vector<int>) == sizeof(int*) + 2 * sizeof(size_t));
+    CountingResource r1;
+    CountingResource r2;
+    {
+        PmrVector v{std::pmr::polymorphic_allocator<std::string>(&r1)};
+        v.PushBack("a");
+        v.PushBack("b");
+        v.PushBack("c");
+        assert(r1.allocations == 3);
+        assert(v.GetAllocator().resource() == &r1);
+
+        PmrVector w(10, std::pmr::polymorphic_allocator<std::string>(&r2));
+        // polymorphic_allocator не распространяется при перемещении: элементы переносятся в память r2
+        w = std::move(v);
+        assert(w.GetAllocator().resource() == &r2);
+        assert(w.Size() == 3);
+        assert(w[2] == "c");
+        assert(r1.bytes_in_use != 0);
+
+        const PmrVector copy(w);
+        assert(copy.GetAllocator().resource() == std::pmr::get_default_resource());
+        assert(copy.Size() == 3);
+
+        PmrVector u{std::pmr::polymorphic_allocator<std::string>(&r2)};
+        u.Swap(w);
+        assert(u.Size() == 3 && w.Size() == 0);
+        PmrVector moved(std::move(u));
+        assert(moved.GetAllocator().resource() == &r2);
+        assert(moved[0] == "a");
     }
-    C(C&& /*other*/) noexcept {
-        ++move_ctor;
+    assert(r1.bytes_in_use == 0);
+    assert(r2.bytes_in_use == 0);
+    {
+        std::byte buffer[1024];
+        std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        Vector<int, std::pmr::polymorphic_allocator<int>> v{std::pmr::polymorphic_allocator<int>(&arena)};
+        for (int i = 0; i < 64; ++i) {
+            v.PushBack(i);
+        }
+        assert(v[63] == 63);
+        assert(reinterpret_cast<std::byte*>(v.begin()) >= buffer);
+        assert(reinterpret_cast<std::byte*>(v.end()) <= buffer + sizeof(buffer));
     }
-    C& operator=(const C& other) noexcept {
-        if (this != &other) {
-            ++copy_assign;
+}
+
+void Test9() {
+    struct alignas(128) Wide {
+        char bytes[128];
+    };
+    const auto is_aligned = [](const void* p, size_t alignment) {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    };
+    {
+        Vector<Wide> v;
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack();
+            assert(is_aligned(v.begin(), alignof(Wide)));
         }
-        return *this;
     }
-    C& operator=(C&& /*other*/) noexcept {
-        ++move_assign;
-        return *this;
+    {
+        AlignedVector<float> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(is_aligned(v.begin(), CACHE_LINE_SIZE));
+        }
+        AlignedVector<float> copy(v);
+        assert(is_aligned(copy.begin(), CACHE_LINE_SIZE));
+        assert(copy[99] == 99.0f);
     }
-    ~C() {
-        ++dtor;
+    {
+        AlignedVector<Wide, 16> v(3);
+        assert(is_aligned(v.begin(), alignof(Wide)));
     }
+}
 
-    static void Reset() {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
+void Test10() {
+    const auto capacities_after_push_backs = [](auto v, int count) {
+        std::vector<size_t> capacities;
+        for (int i = 0; i < count; ++i) {
+            v.PushBack(i);
+            if (capacities.empty() || capacities.back() != v.Capacity()) {
+                capacities.push_back(v.Capacity());
+            }
+        }
+        return capacities;
+    };
+    {
+        const std::vector<size_t> expected{1, 2, 4, 8, 16};
+        assert(capacities_after_push_backs(Vector<int>{}, 10) == expected);
+    }
+    {
+        const std::vector<size_t> expected{1, 2, 3, 4, 6, 9, 13};
+        assert(capacities_after_push_backs(Vector<int, std::allocator<int>, OneAndHalfGrowth>{}, 10) == expected);
+    }
+    {
+        // Порог 32 байта = 8 элементов типа int
+        using Policy = DoublingThenLinearGrowth<8 * sizeof(int)>;
+        const std::vector<size_t> expected{1, 2, 4, 8, 16, 24};
+        assert(capacities_after_push_backs(Vector<int, std::allocator<int>, Policy>{}, 20) == expected);
+    }
+    {
+        const std::vector<size_t> expected{CACHE_LINE_SIZE / sizeof(int), CACHE_LINE_SIZE / sizeof(int) * 2};
+        assert(capacities_after_push_backs(Vector<int, std::allocator<int>, CacheLineMinGrowth<>>{}, 20) == expected);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj, std::allocator<Obj>, OneAndHalfGrowth> v(10);
+        v.Insert(v.cbegin() + 5, Obj{1});
+        assert(v.Capacity() == 15);
+        assert(v[5].id == 1);
+        assert(Obj::num_copied == 0);
     }
+}
 
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
-};
+void Test11() {
+    const size_t SIZE = 10;
+    static_assert(RawMemory<int, MallocAllocator<int>>::CanExpand());
+    static_assert(RawMemory<int, MallocAllocator<int>>::CanReallocate());
+    static_assert(!RawMemory<int>::CanExpand() && !RawMemory<int>::CanReallocate());
+    {
+        Obj::ResetCounters();
+        Vector<Obj, SlabAllocator<Obj>> v(SIZE);
+        const Obj* data = v.begin();
+        v.Reserve(SIZE * 10);
+        assert(v.begin() == data);
+        assert(v.Capacity() == SIZE * 10);
+        assert(Obj::num_moved == 0 && Obj::num_copied == 0);
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-         << ", Copy ctors: "sv << C::copy_ctor          //
-         << ", Move ctors: "sv << C::move_ctor          //
-         << ", Copy assignments: "sv << C::copy_assign  //
-         << ", Move assignments: "sv << C::move_assign  //
-         << ", Dtors: "sv << C::dtor << endl;
+        v.Resize(v.Capacity());
+        v.PushBack(v[0]);
+        v.Insert(v.cbegin(), v[1]);
+        assert(v.begin() == data);
+        assert(v.Capacity() == SIZE * 10 * 2);
+        assert(Obj::num_copied == 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<int, MallocAllocator<int>> v;
+        for (int i = 0; i < 100'000; ++i) {
+            v.PushBack(i);
+        }
+        v.Insert(v.cbegin(), v[v.Size() - 1]);
+        v.Reserve(v.Capacity() * 4);
+        assert(v.Size() == 100'001);
+        assert(v[0] == 99'999);
+        for (int i = 0; i < 100'000; ++i) {
+            assert(v[i + 1] == i);
+        }
+    }
 }
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+void Test12() {
+    const size_t SIZE = 4;
+    const int ID = 42;
+    using namespace std::literals;
+    {
+        Obj::ResetCounters();
+        CountingResource resource;
+        using PmrSmallVector = SmallVector<Obj, SIZE, std::pmr::polymorphic_allocator<Obj>>;
+        PmrSmallVector v{std::pmr::polymorphic_allocator<Obj>(&resource)};
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
         }
-        Dump();
-    } catch (...) {
+        assert(v.IsInline());
+        assert(v.Capacity() == SIZE);
+        assert(resource.allocations == 0);
+        v.Insert(v.cbegin() + 1, Obj{ID});
+        assert(!v.IsInline());
+        assert(resource.allocations == 1);
+        assert(v.Capacity() == SIZE * 2);
+        assert(v[1].id == ID && v[2].id == 1 && v[SIZE].id == SIZE - 1);
+        v.Erase(v.cbegin());
+        assert(v.Size() == SIZE);
+        assert(v[0].id == ID);
+        assert(Obj::num_copied == 0);
     }
-    try {
-        const size_t NUM = 10;
-        C c;
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, SIZE> v(SIZE);
+        v[0].id = ID;
+        SmallVector<Obj, SIZE> moved(std::move(v));
+        assert(moved.IsInline() && moved.Size() == SIZE && v.Size() == 0);
+        assert(moved[0].id == ID);
+        assert(Obj::num_moved == SIZE);
+        assert(Obj::GetAliveObjectCount() == SIZE);
+
+        SmallVector<Obj, SIZE> copy(moved);
+        assert(copy.Size() == SIZE && copy[0].id == ID);
+        copy.Resize(SIZE * 3);
+        assert(!copy.IsInline());
+        moved = copy;
+        assert(moved.Size() == SIZE * 3);
+        copy = std::move(v);
+        assert(copy.Size() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SmallVector<std::string, 2> a;
+        a.PushBack("a"s);
+        SmallVector<std::string, 2> b;
+        b.PushBack("x"s);
+        b.PushBack("y"s);
+        b.PushBack("z"s);
+        a.Swap(b);
+        assert(a.Size() == 3 && a[2] == "z"s);
+        assert(b.Size() == 1 && b[0] == "a"s && b.IsInline());
+        a.EmplaceBack(a[0]);
+        assert(a[3] == "x"s);
+        a.PopBack();
+        assert(std::equal(a.begin(), a.end(), std::vector{"x"s, "y"s, "z"s}.begin()));
+    }
+}
+
+void Test13() {
+    const size_t SIZE = 10;
+    const int ID = 42;
+    {
+        Vector<int> v;
+        const int source[] = {1, 2, 3, 4};
+        v.Append(std::begin(source), std::end(source));
+        assert(v.Capacity() == 4);
+        v.Insert(v.cbegin() + 1, std::begin(source), std::end(source));
+        assert(v.Capacity() == 8);
+        v.Insert(v.cbegin(), 3, v[7]);
+        v.Insert(v.cend(), 0, 0);
+        const std::vector<int> expected{4, 4, 4, 1, 1, 2, 3, 4, 2, 3, 4};
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+        std::istringstream input("7 8 9");
+        v.Insert(v.cbegin() + 2, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(v.Size() == expected.size() + 3);
+        assert(v[2] == 7 && v[3] == 8 && v[4] == 9 && v[5] == 4);
+
+        v.Assign(std::begin(source), std::begin(source) + 2);
+        assert(v.Size() == 2 && v[1] == 2);
+        std::istringstream more("5 6 7");
+        v.Assign(std::istream_iterator<int>(more), std::istream_iterator<int>());
+        assert(v.Size() == 3 && v[0] == 5 && v[2] == 7);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        std::vector<Obj> source(3);
+        source[1].id = ID;
+        Obj::ResetCounters();
+        v.Insert(v.cbegin() + 2, source.begin(), source.end());
+        assert(v.Size() == SIZE + 3);
+        assert(v.Capacity() == SIZE * 2);
+        assert(v[3].id == ID);
+        assert(Obj::num_copied == 3);
+        assert(Obj::num_moved == SIZE);
+        assert(Obj::num_move_assigned == 0);
+
+        // Вставка без реаллокации: хвост длиннее вставляемого диапазона
+        Obj::ResetCounters();
+        v.Insert(v.cbegin() + 1, source.begin(), source.end());
+        assert(v.Size() == SIZE + 6);
+        assert(v[2].id == ID && v[6].id == ID);
+        assert(Obj::num_moved == 3);
+        assert(Obj::num_move_assigned == SIZE + 3 - 1 - 3);
+        assert(Obj::num_assigned == 3);
+
+        // Вставка без реаллокации: хвост короче вставляемого диапазона
+        Obj::ResetCounters();
+        v.Insert(v.cend() - 1, source.begin(), source.end());
+        assert(v.Size() == SIZE + 9);
+        assert(v[SIZE + 6].id == ID);
+        assert(Obj::num_copied == 2 && Obj::num_assigned == 1 && Obj::num_moved == 1);
+
+        Obj::ResetCounters();
+        v.Insert(v.cbegin(), 5, v[SIZE + 6]);
+        assert(v.Size() == SIZE + 14);
+        assert(v[0].id == ID && v[4].id == ID && v[SIZE + 11].id == ID);
+        assert(Obj::num_moved == SIZE + 9);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        std::vector<Obj> source(3);
+        source[2].throw_on_copy = true;
+        try {
+            v.Insert(v.cbegin() + 1, source.begin(), source.end());
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        assert(Obj::GetAliveObjectCount() == SIZE + 3);
+
+        Obj::ResetCounters();
+        v.Assign(source.begin(), source.begin() + 2);
+        assert(v.Size() == 2 && v.Capacity() == SIZE);
+        assert(Obj::num_assigned == 2 && Obj::num_destroyed == SIZE - 2);
+    }
+}
+
+void Test14() {
+    const size_t SIZE = 10;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        auto* pos = v.Erase(v.cbegin() + 2, v.cbegin() + 5);
+        assert(pos == v.begin() + 2 && pos->id == 5);
+        assert(v.Size() == SIZE - 3);
+        assert(Obj::num_move_assigned == SIZE - 5);
+        assert(Obj::num_destroyed == 3);
+        assert(v.Erase(v.cbegin() + 1, v.cbegin() + 1) == v.begin() + 1);
+        assert(v.Erase(v.cbegin() + 4, v.cend()) == v.end());
+        assert(v.Size() == 4 && v[3].id == 6);
+
+        Obj::ResetCounters();
+        assert(EraseIf(v, [](const Obj& obj) { return obj.id % 2 == 0; }) == 2);
+        assert(v.Size() == 2 && v[0].id == 1 && v[1].id == 5);
+        assert(Obj::num_destroyed == 2);
+    }
+    {
+        Handle::ResetCounters();
+        Vector<Handle> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Erase(v.cbegin(), v.cbegin() + 2);
+        assert(*v[0].value == 2);
+        assert(EraseIf(v, [](const Handle& h) { return *h.value % 3 == 0; }) == 3);
+        assert(v.Size() == 5);
+        assert(*v[0].value == 2 && *v[1].value == 4 && *v[4].value == 8);
+        assert(Handle::num_move_assigned == 0 && Handle::num_moved == 0);
+        assert(Handle::num_destroyed == 5);
+
+        // Исключение из предиката не оставляет «дыр» в буфере
+        try {
+            EraseIf(v, [](const Handle& h) {
+                if (*h.value == 7) {
+                    throw std::runtime_error("Oops");
+                }
+                return *h.value == 4;
+            });
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 4);
+        assert(*v[0].value == 2 && *v[1].value == 5 && *v[2].value == 7 && *v[3].value == 8);
+    }
+}
+
+void Test15() {
+    const size_t SIZE = 10;
+    const int ID_FOR_SLOTS = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        auto* pos = v.EraseUnordered(v.cbegin() + 2);
+        assert(pos->id == SIZE - 1);
+        assert(v.Size() == SIZE - 1);
+        assert(Obj::num_move_assigned == 1);
+        pos = v.EraseUnordered(v.cend() - 1);
+        assert(pos == v.end());
+        assert(v.Size() == SIZE - 2);
+        assert(Obj::num_move_assigned == 1 && Obj::num_destroyed == 2);
+    }
+    {
+        Vector<int> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(i);
+        }
+        v.EraseUnordered(v.cbegin());
+        const std::vector<int> expected{4, 1, 2, 3};
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    }
+    {
+        Obj::ResetCounters();
+        SlotVector<Obj> slots;
+        std::vector<size_t> ids;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            ids.push_back(slots.Emplace(i));
+        }
+        assert(slots.Size() == SIZE);
+        slots.Erase(ids[3]);
+        slots.Erase(ids[7]);
+        assert(slots.Size() == SIZE - 2);
+        assert(!slots.Contains(ids[3]) && slots.Contains(ids[4]));
+        assert(slots[ids[8]].id == 8);
+
+        const int old_num_moved = Obj::num_moved;
+        const size_t reused = slots.Emplace(ID_FOR_SLOTS);
+        assert(reused == ids[7]);
+        assert(Obj::num_moved == old_num_moved && Obj::num_move_assigned == 0);
+        assert(slots[reused].id == ID_FOR_SLOTS);
+
+        int sum = 0;
+        size_t count = 0;
+        for (const Obj& obj : slots) {
+            sum += obj.id;
+            ++count;
+        }
+        assert(count == SIZE - 1);
+        assert(sum == 45 - 3 - 7 + ID_FOR_SLOTS);
+
+        slots.Reserve(SIZE * 4);
+        assert(slots[ids[9]].id == 9 && !slots.Contains(ids[3]));
+        assert(slots.Emplace(0) == ids[3]);
+        assert(slots.Emplace(0) == SIZE);
+
+        SlotVector<Obj> moved(std::move(slots));
+        assert(moved.Size() == SIZE + 1 && slots.Size() == 0);
+
+        // Исключение при создании элемента в свободной ячейке не портит список свободных ячеек
+        moved.Erase(ids[3]);
+        moved.Erase(ids[7]);
+        Obj::default_construction_throw_countdown = 1;
+        try {
+            moved.Emplace();
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(moved.Size() == SIZE - 1 && !moved.Contains(ids[7]));
+        assert(moved.Emplace(1) == ids[7] && moved.Emplace(2) == ids[3] && moved.Emplace(3) == SIZE + 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test16() {
+    const size_t SIZE = 1000;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE, DEFAULT_INIT);
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        assert(Obj::num_default_constructed == SIZE);
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(Obj::num_default_constructed == SIZE * 2);
+        v.ResizeDefaultInit(SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        assert(Obj::GetAliveObjectCount() == SIZE / 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<uint8_t> buffer(SIZE, DEFAULT_INIT);
+        std::fill(buffer.begin(), buffer.end(), uint8_t{7});
+        buffer.ResizeDefaultInit(SIZE * 4);
+        assert(buffer.Size() == SIZE * 4);
+        assert(buffer[SIZE - 1] == 7);
+        buffer.Resize(SIZE * 5);
+        assert(buffer[SIZE * 5 - 1] == 0);
+    }
+}
+
+void Test17() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        assert(v.MemoryUsage() == SIZE * 2 * sizeof(Obj));
+        const int old_num_moved = Obj::num_moved;
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE && v.Size() == SIZE);
+        assert(Obj::num_moved == old_num_moved + static_cast<int>(SIZE));
+        v.ShrinkToFit();
+        assert(Obj::num_moved == old_num_moved + static_cast<int>(SIZE));
+
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() == SIZE);
+        assert(Obj::GetAliveObjectCount() == 0);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0 && v.MemoryUsage() == 0);
+        v.EmplaceBack(1);
+        assert(v.Size() == 1 && v[0].id == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<int, MallocAllocator<int>> v;
+        for (int i = 0; i < static_cast<int>(SIZE) + 1; ++i) {
+            v.PushBack(i);
+        }
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE + 1);
+        assert(v[SIZE] == static_cast<int>(SIZE));
+    }
+}
+
+struct IntStatsTag {};
+struct ObjStatsTag {};
+
+void Test18() {
+    static_assert(sizeof(Vector<int>) == sizeof(int*) + 2 * sizeof(size_t));
+    const size_t SIZE = 100;
+    {
+        using Stats = CountingStats<IntStatsTag>;
+        Stats::Reset();
+        {
+            Vector<int, std::allocator<int>, DoublingGrowth, Stats> v;
+            for (size_t i = 0; i < SIZE; ++i) {
+                v.PushBack(static_cast<int>(i));
+            }
+            const VectorStats stats = Stats::Get();
+            // Ёмкости 1, 2, 4, ..., 128
+            assert(stats.allocations == 8 && stats.deallocations == 7);
+            assert(stats.peak_capacity == 128);
+            assert(stats.allocated_bytes == 255 * sizeof(int));
+            assert(stats.relocated == 127);
+            assert(stats.moved == 0 && stats.copied == 0);
+
+            auto copy = v;
+            assert(Stats::Get().copied == SIZE);
+        }
+        const VectorStats stats = Stats::Get();
+        assert(stats.allocations == 9 && stats.deallocations == 9);
+        Stats::Reset();
+        assert(Stats::Get().allocations == 0);
+    }
+    {
+        using Stats = CountingStats<ObjStatsTag>;
+        Stats::Reset();
+        Obj::ResetCounters();
+        {
+            Vector<Obj, std::allocator<Obj>, DoublingGrowth, Stats> v;
+            v.Reserve(SIZE);
+            v.Resize(SIZE);
+            v.Reserve(SIZE * 2);
+            const VectorStats stats = Stats::Get();
+            assert(stats.allocations == 2 && stats.deallocations == 1);
+            assert(stats.moved == SIZE && stats.relocated == 0);
+            assert(stats.moved == static_cast<size_t>(Obj::num_moved));
+        }
+        assert(Stats::Get().deallocations == 2);
+        // Счётчики разных тегов независимы
+        assert(CountingStats<IntStatsTag>::Get().allocations == 0);
+    }
+}
+
+void Test19() {
+    const int SIZE = 5;
+    {
+        Vector<Obj> v;
+        v.Reserve(SIZE * 2);
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(i);
+        }
+        Obj::ResetCounters();
+        // Вставка перемещением выполняется без временного объекта
+        v.Insert(v.begin() + 1, std::move(v[3]));
+        assert(v.Size() == SIZE + 1);
+        assert(v[1].id == 3 && v[4].id == 3);
+        assert(Obj::num_moved == 1 && Obj::num_copied == 0);
+        assert(Obj::num_destroyed == 0);
+
+        // Копирование может бросить исключение, поэтому значение сначала копируется во временный объект
+        v.Insert(v.begin(), v[2]);
+        assert(v[0].id == 1 && v[1].id == 0 && v[2].id == 3);
+        v.Insert(v.begin(), v[v.Size() - 1]);
+        assert(v[0].id == SIZE - 1);
+    }
+    {
+        Handle::ResetCounters();
+        Vector<Handle> v;
+        v.Reserve(SIZE * 2);
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Insert(v.begin(), std::move(v[2]));
+        assert(*v[0].value == 2 && v[3].value == nullptr);
+        assert(Handle::num_moved == 1 && Handle::num_move_assigned == 0);
+        assert(Handle::num_destroyed == 0);
+    }
+    {
+        Vector<std::string> v;
+        v.Reserve(SIZE * 2);
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        v.Insert(v.begin(), v[1]);
+        v.Emplace(v.begin() + 1, std::move(v[v.Size() - 1]));
+        assert(v[0] == "1" && v[1] == "4" && v[2] == "0" && v[3] == "1");
+        assert(v.Size() == SIZE + 2);
+    }
+    {
+        // Перевыделение через realloc: аргумент, ссылающийся на элемент, остаётся валидным
+        Vector<int, MallocAllocator<int>> v;
+        const int COUNT = 1000;
+        for (int i = 0; i < COUNT; ++i) {
+            v.PushBack(i);
+            v.Insert(v.begin(), v[v.Size() - 1]);
+        }
+        for (int i = 0; i < COUNT; ++i) {
+            assert(v[i] == COUNT - 1 - i);
+            assert(v[COUNT + i] == i);
+        }
+    }
+}
+
+// Элемент с потокобезопасными счётчиками для проверки параллельных операций
+struct Cell {
+    Cell() {
+        if (throw_countdown.fetch_sub(1) == 1) {
+            throw std::runtime_error("Oops");
+        }
+        ++alive;
+    }
+
+    Cell(const Cell& other)
+            : value(other.value)  //
+    {
+        if (throw_countdown.fetch_sub(1) == 1) {
+            throw std::runtime_error("Oops");
+        }
+        ++alive;
+    }
+
+    Cell& operator=(const Cell&) = default;
+
+    ~Cell() {
+        --alive;
+    }
+
+    int value = 7;
+
+    static inline std::atomic<int> alive{0};
+    // Обратный отсчёт до создания, выбрасывающего исключение; неположительное значение отключает его
+    static inline std::atomic<int> throw_countdown{0};
+};
+
+void Test20() {
+    const size_t SIZE = size_t{1} << 20;
+    const ParallelTag policy(4);
+    {
+        Vector<int> v(policy, SIZE);
+        assert(v.Size() == SIZE);
+        assert(std::all_of(v.begin(), v.end(), [](int x) { return x == 0; }));
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        Vector<int> copy(policy, v);
+        assert(std::equal(v.begin(), v.end(), copy.begin(), copy.end()));
+
+        copy.Resize(policy, SIZE * 3);
+        assert(copy.Size() == SIZE * 3 && copy[SIZE - 1] == static_cast<int>(SIZE - 1));
+        assert(std::all_of(copy.begin() + SIZE, copy.end(), [](int x) { return x == 0; }));
+        copy.Resize(policy, 1);
+        assert(copy.Size() == 1 && copy[0] == 0);
+        copy.Clear(PARALLEL);
+        assert(copy.Size() == 0);
+    }
+    {
+        Vector<std::string> v(policy, SIZE / 16);
+        v[0] = "first";
+        v[v.Size() - 1] = "last";
+        v.Reserve(policy, v.Size() * 2);
+        assert(v[0] == "first" && v[v.Size() - 1] == "last");
+        const Vector<std::string> copy(policy, v);
+        assert(copy[0] == "first" && copy[copy.Size() - 1] == "last");
+    }
+    {
+        Cell::throw_countdown = -1;
+        Vector<Cell> v(policy, SIZE);
+        assert(Cell::alive == static_cast<int>(SIZE));
+        v.Reserve(policy, SIZE * 2);
+        assert(Cell::alive == static_cast<int>(SIZE) && v.Capacity() == SIZE * 2);
+        v.Clear(policy);
+        assert(Cell::alive == 0);
+        v.Resize(policy, SIZE);
+        assert(Cell::alive == static_cast<int>(SIZE));
+    }
+    assert(Cell::alive == 0);
+    {
+        // Исключение в одной из частей откатывает созданные элементы всех частей
+        Cell::throw_countdown = static_cast<int>(SIZE / 2);
+        try {
+            Vector<Cell> v(policy, SIZE);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(Cell::alive == 0);
+
+        Cell::throw_countdown = -1;
+        Vector<Cell> v(policy, SIZE);
+        v[SIZE - 1].value = 42;
+        Cell::throw_countdown = static_cast<int>(SIZE / 3);
+        // Копирующий перенос при исключении оставляет исходные элементы нетронутыми
+        try {
+            v.Reserve(policy, SIZE * 2);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Capacity() == SIZE && v[SIZE - 1].value == 42);
+        assert(Cell::alive == static_cast<int>(SIZE));
+        Cell::throw_countdown = -1;
+    }
+    assert(Cell::alive == 0);
+}
+
+void Test21() {
+    {
+        // Порог в 64 КиБ: буфер переходит из malloc в отображение и обратно
+        Vector<int, MmapAllocator<int, size_t{1} << 16>> v;
+        const int SIZE = 1 << 20;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        assert(reinterpret_cast<std::uintptr_t>(&v[0]) % getpagesize() == 0);
+        for (int i = 0; i < SIZE; ++i) {
+            assert(v[i] == i);
+        }
+        v.Resize(100);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 100 && v[99] == 99);
+    }
+    {
+        Vector<double, MmapAllocator<double, HUGE_PAGE_SIZE, true>> v(HUGE_PAGE_SIZE / sizeof(double) + 1);
+        v[v.Size() - 1] = 1.5;
+        v.Reserve(v.Capacity() * 4);
+        assert(v[v.Size() - 1] == 1.5 && v[0] == 0.0);
+    }
+    {
+        const std::string path = "/tmp/advanced_vector_test_" + std::to_string(getpid()) + ".bin";
+        const size_t SIZE = 100000;
+        {
+            FileMappedAllocator<int> alloc(path);
+            assert(alloc.StoredSize() == 0);
+            Vector<int, FileMappedAllocator<int>> v(alloc);
+            for (size_t i = 0; i < SIZE; ++i) {
+                v.PushBack(static_cast<int>(i * 3));
+            }
+            v.ShrinkToFit();
+            // Второй буфер в том же файле выделить нельзя
+            try {
+                Vector<int, FileMappedAllocator<int>> copy(v);
+                assert(false);
+            } catch (const std::bad_alloc&) {
+            }
+            Vector<int> copy;
+            copy.Assign(v.begin(), v.end());
+            assert(copy.Size() == SIZE);
+        }
+        {
+            FileMappedAllocator<int> alloc(path);
+            assert(alloc.StoredSize() == SIZE);
+            Vector<int, FileMappedAllocator<int>> v(alloc.StoredSize(), DEFAULT_INIT, alloc);
+            for (size_t i = 0; i < SIZE; ++i) {
+                assert(v[i] == static_cast<int>(i * 3));
+            }
+            v.PopBack();
+            v.ShrinkToFit();
+        }
+        assert(FileMappedAllocator<int>(path).StoredSize() == SIZE - 1);
+        {
+            // Assign и присваивание большего вектора перевыделяют единственный буфер файла на месте
+            FileMappedAllocator<int> alloc(path);
+            Vector<int, FileMappedAllocator<int>> v(alloc.StoredSize(), DEFAULT_INIT, alloc);
+            const std::vector<int> source(SIZE + 100, 7);
+            v.Assign(source.begin(), source.end());
+            assert(v.Size() == SIZE + 100 && v[SIZE + 99] == 7);
+
+            const std::string other_path = path + ".other";
+            Vector<int, FileMappedAllocator<int>> w{FileMappedAllocator<int>(other_path)};
+            w.Resize(SIZE * 2);
+            w[SIZE * 2 - 1] = 5;
+            v = w;
+            assert(v.Size() == SIZE * 2 && v[SIZE * 2 - 1] == 5 && v.GetAllocator() != w.GetAllocator());
+            unlink(other_path.c_str());
+
+            // Сжатие пустого вектора обрезает файл: прежние элементы не возвращаются при открытии
+            v.Clear();
+            v.ShrinkToFit();
+            assert(v.Capacity() == 0);
+        }
+        assert(FileMappedAllocator<int>(path).StoredSize() == 0);
+        unlink(path.c_str());
+    }
+}
+
+struct AdoptStatsTag {};
+
+struct Point {
+    int x;
+    double y;
+};
+
+void Test22() {
+    const size_t SIZE = 50000;
+    {
+        Vector<Obj> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack(i);
+        }
+        Obj::ResetCounters();
+        auto buffer = v.ReleaseBuffer();
+        assert(v.Size() == 0 && v.Capacity() == 0);
+        assert(buffer.size == 10 && buffer.capacity >= 10 && buffer.data[9].id == 9);
+
+        Vector<Obj> other;
+        other.EmplaceBack(100);
+        other.AdoptBuffer(buffer);
+        assert(other.Size() == 10 && other[0].id == 0 && other[9].id == 9);
+        assert(Obj::num_moved == 0 && Obj::num_copied == 0);
+        assert(Obj::num_destroyed == 1);
+    }
+    {
+        // Передача буфера учитывается политикой статистики как освобождение и выделение,
+        // в том числе для буфера, выделенного в обход вектора
+        using Stats = CountingStats<AdoptStatsTag>;
+        using StatsVector = Vector<int, std::allocator<int>, DoublingGrowth, Stats>;
+        Stats::Reset();
+        {
+            StatsVector v;
+            v.Reserve(8);
+            v.PushBack(1);
+            auto buffer = v.ReleaseBuffer();
+            assert(Stats::Get().allocations == 1 && Stats::Get().deallocations == 1);
+
+            StatsVector other;
+            other.AdoptBuffer(buffer);
+            assert(Stats::Get().allocations == 2 && Stats::Get().deallocations == 1);
+
+            int* foreign = std::allocator<int>().allocate(4);
+            foreign[0] = 7;
+            other.AdoptBuffer({foreign, 1, 4});
+            assert(other[0] == 7);
+            assert(Stats::Get().allocations == 3 && Stats::Get().deallocations == 2);
+        }
+        const VectorStats stats = Stats::Get();
+        assert(stats.allocations == 3 && stats.deallocations == 3);
+    }
+    {
+        Vector<Point> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack({static_cast<int>(i), i * 0.5});
+        }
+        assert(v.ByteSize() == SIZE * sizeof(Point));
+        assert(v.Bytes() == reinterpret_cast<const std::byte*>(&v[0]));
+
+        const std::string path = "/tmp/advanced_vector_serialized_" + std::to_string(getpid()) + ".bin";
+        const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0);
+        unlink(path.c_str());
+        WriteVector(fd, v);
+        WriteVector(fd, Vector<Point>());
+        lseek(fd, 0, SEEK_SET);
+
+        const auto restored = ReadVector<Point>(fd);
+        assert(restored.Size() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(restored[i].x == static_cast<int>(i) && restored[i].y == i * 0.5);
+        }
+        assert(ReadVector<Point>(fd).Size() == 0);
+        try {
+            ReadVector<Point>(fd);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+
+        lseek(fd, 0, SEEK_SET);
+        try {
+            ReadVector<int>(fd);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        close(fd);
+    }
+}
+
+void Test23() {
+    const size_t SIZE = 8;
+    {
+        int freed = 0;
+        int* data = static_cast<int*>(std::malloc(SIZE * sizeof(int)));
+        for (size_t i = 0; i < SIZE; ++i) {
+            data[i] = static_cast<int>(i);
+        }
+        const auto deleter = [](int* p, size_t capacity, void* context) noexcept {
+            assert(capacity == SIZE);
+            ++*static_cast<int*>(context);
+            std::free(p);
+        };
+        {
+            auto v = AdoptForeignBuffer(data, SIZE / 2, SIZE, deleter, &freed);
+            assert(v.Size() == SIZE / 2 && v.Capacity() == SIZE);
+            assert(&v[0] == data && v[3] == 3);
+            v.PushBack(42);
+            assert(&v[0] == data && v[4] == 42);
+
+            auto copy = v;
+            assert(copy.GetAllocator().ForeignBuffer() == nullptr && copy[4] == 42);
+
+            v.Resize(SIZE + 1);
+            assert(freed == 1 && &v[0] != data);
+            assert(v[3] == 3 && v[4] == 42 && v[SIZE] == 0);
+        }
+        assert(freed == 1);
+
+        int* other = static_cast<int*>(std::malloc(SIZE * sizeof(int)));
+        {
+            auto v = AdoptForeignBuffer(other, 0, SIZE, deleter, &freed);
+            v.PushBack(1);
+        }
+        assert(freed == 2);
+
+        // После освобождения внешнего буфера совпавший с ним адрес нового буфера не передаётся deleter
+        int* third = static_cast<int*>(std::malloc(SIZE * sizeof(int)));
+        {
+            auto v = AdoptForeignBuffer(third, SIZE, SIZE, deleter, &freed);
+            v.Reserve(SIZE * 2);
+            assert(freed == 3 && v.GetAllocator().ForeignBuffer() == nullptr);
+            v.ShrinkToFit();
+            assert(v.Capacity() == SIZE);
+        }
+        assert(freed == 3);
+    }
+    {
+        Vector<Obj> v;
+        v.Reserve(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        Obj::ResetCounters();
+        auto owned = ReleaseOwned(v);
+        assert(v.Size() == 0 && v.Capacity() == 0);
+        assert(owned.get_deleter().Size() == SIZE && owned[SIZE - 1].id == static_cast<int>(SIZE - 1));
+        owned.reset();
+        assert(Obj::num_destroyed == static_cast<int>(SIZE));
+    }
+}
+
+void Test24() {
+    static_assert(SegmentedVector<int>::CHUNK_CAPACITY == 1024);
+    static_assert(SegmentedVector<char[3000]>::CHUNK_CAPACITY == 1);
+    const int SIZE = 1000;
+    {
+        SegmentedVector<Obj, 16> v;
+        Obj::ResetCounters();
+        const Obj* first = &v.EmplaceBack(0);
+        for (int i = 1; i < SIZE; ++i) {
+            v.EmplaceBack(i);
+        }
+        // Рост не переносит элементы
+        assert(&v[0] == first);
+        assert(Obj::num_moved == 0 && Obj::num_copied == 0);
+        assert(v.Size() == SIZE && v.Capacity() == 1008);
+        assert(v.ChunkCount() == 63 && v.ChunkSize(62) == 8 && v.ChunkSize(0) == 16);
+
+        for (int i = 0; i < SIZE; ++i) {
+            assert(v[i].id == i);
+        }
+        int expected = 0;
+        for (const Obj& obj : v) {
+            assert(obj.id == expected++);
+        }
+        assert(v.end() - v.begin() == SIZE);
+        assert((v.begin() + 500)->id == 500 && (v.end() - 1)->id == SIZE - 1);
+        assert(std::find_if(v.begin(), v.end(), [](const Obj& obj) { return obj.id == 777; }) - v.begin() == 777);
+
+        size_t total = 0;
+        v.ForEachChunk([&total](Obj* data, size_t size) {
+            assert(data[0].id == static_cast<int>(total));
+            total += size;
+        });
+        assert(total == SIZE);
+
+        // Аргумент, ссылающийся на элемент, остаётся валидным при добавлении блока
+        while (v.Size() != v.Capacity()) {
+            v.EmplaceBack(static_cast<int>(v.Size()));
+        }
+        v.EmplaceBack(v[0]);
+        assert(v.Capacity() == 1024 && v[v.Size() - 1].id == 0);
+        while (v.Size() != SIZE) {
+            v.PopBack();
+        }
+        SegmentedVector<Obj, 16> copy(v);
+        assert(copy.Size() == v.Size() && copy[SIZE - 1].id == SIZE - 1);
+
+        v.PopBack();
+        assert(v.Size() == SIZE - 1);
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() == 1024);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+        v.PushBack(Obj(5));
+        assert(v[0].id == 5);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SegmentedVector<std::string, 4> v;
+        v.Reserve(10);
+        assert(v.Capacity() == 12);
+        for (int i = 0; i < 4; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        v.EmplaceBack(v[1]);
+        assert(v[4] == "1");
+        std::sort(v.begin(), v.end(), std::greater<>());
+        assert(v[0] == "3" && v[4] == "0");
+    }
+}
+
+void Test25() {
+    const int SIZE = 100;
+    {
+        SoAVector<float, double, int> v;
+        for (int i = 0; i < SIZE; ++i) {
+            auto [x, y, id] = v.EmplaceBack(i * 1.0f, i * 2.0, i);
+            assert(x == i * 1.0f && y == i * 2.0 && id == i);
+        }
+        assert(v.Size() == SIZE && v.Capacity() == 128);
+        assert(reinterpret_cast<std::uintptr_t>(v.Column<0>().Data()) % CACHE_LINE_SIZE == 0);
+        assert(reinterpret_cast<std::uintptr_t>(v.Column<1>().Data()) % CACHE_LINE_SIZE == 0);
+
+        double sum = 0;
+        for (double y : v.Column<1>()) {
+            sum += y;
+        }
+        assert(sum == SIZE * (SIZE - 1));
+        for (int& id : v.Column<2>()) {
+            id *= 10;
+        }
+        std::get<0>(v[5]) = -1.0f;
+        const auto& cv = v;
+        assert(std::get<0>(cv[5]) == -1.0f && std::get<2>(cv[5]) == 50);
+        assert(cv.Column<2>().Size() == SIZE);
+
+        v.EmplaceBack(std::get<0>(v[5]), std::get<1>(v[7]), std::get<2>(v[9]));
+        assert(v[SIZE] == std::make_tuple(-1.0f, 14.0, 90));
+
+        SoAVector<float, double, int> copy(v);
+        v.Resize(10);
+        assert(v.Size() == 10 && std::get<2>(v[9]) == 90);
+        v.Resize(20);
+        assert(std::get<1>(v[19]) == 0.0);
+        assert(copy.Size() == SIZE + 1 && std::get<2>(copy[SIZE - 1]) == (SIZE - 1) * 10);
+        v = std::move(copy);
+        assert(v.Size() == SIZE + 1);
+        v.PopBack();
+        v.Clear();
+        assert(v.Size() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        SoAVector<std::string, Obj> v;
+        v.Reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(std::to_string(i), i);
+        }
+        // Obj перемещается без исключений, поэтому переносится перемещением
+        v.EmplaceBack("4", 4);
+        assert(Obj::num_moved == 4 && Obj::num_copied == 0);
+        assert(std::get<0>(v[4]) == "4" && std::get<1>(v[3]).id == 3);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        struct ThrowingCopy {
+            ThrowingCopy() = default;
+            ThrowingCopy(const ThrowingCopy& other)
+                    : value(other.value) {
+                if (value == 2) {
+                    throw std::runtime_error("Oops");
+                }
+            }
+            int value = 0;
+        };
+        SoAVector<Handle, ThrowingCopy> v;
+        v.Reserve(3);
+        for (int i = 0; i < 3; ++i) {
+            v.EmplaceBack(Handle(i), ThrowingCopy());
+            std::get<1>(v[i]).value = i;
+        }
+        Handle::ResetCounters();
+        try {
+            v.Reserve(10);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        // Столбец Handle ещё не перенесён, когда копирование второго столбца прервалось
+        assert(v.Capacity() == 3 && *std::get<0>(v[2]).value == 2);
+        assert(Handle::num_moved == 0 && Handle::num_destroyed == 0);
+    }
+}
+
+void Test26() {
+    {
+        static_assert(ConcurrentVector<int>::FIRST_SEGMENT_SIZE == 32);
+        ConcurrentVector<std::string> v;
+        assert(v.EmplaceBack("a") == 0);
+        assert(v.PushBack(std::string("b")) == 1);
+        const size_t first = v.ReserveSlots(100);
+        assert(first == 2 && v.Size() == 102);
+        assert(!v.IsCommitted(first) && v.TryGet(50) == nullptr && v.TryGet(1000) == nullptr);
+        const std::string* a = &v[0];
+        for (size_t i = first; i < first + 100; ++i) {
+            v.EmplaceAt(i, std::to_string(i));
+        }
+        // Рост не перемещает опубликованные элементы
+        assert(&v[0] == a && v[1] == "b" && v[101] == "101");
+        v.Clear();
+        assert(v.Size() == 0 && !v.IsCommitted(0));
+        v.EmplaceBack("c");
+        assert(v[0] == "c");
+    }
+    {
+        const size_t THREADS = 8;
+        const size_t PER_THREAD = 20000;
+        const size_t BATCH = 100;
+        ConcurrentVector<std::pair<size_t, size_t>> v;
+        std::atomic<bool> done{false};
+        std::atomic<size_t> seen{0};
+        std::thread reader([&] {
+            while (!done.load()) {
+                const size_t size = v.Size();
+                for (size_t i = 0; i < size; i += 97) {
+                    if (const auto* value = v.TryGet(i)) {
+                        assert(value->first < THREADS && value->second < PER_THREAD);
+                        seen.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+        });
+        std::vector<std::thread> producers;
+        for (size_t t = 0; t < THREADS; ++t) {
+            producers.emplace_back([&v, t] {
+                if (t % 2 == 0) {
+                    for (size_t i = 0; i < PER_THREAD; ++i) {
+                        v.EmplaceBack(t, i);
+                    }
+                } else {
+                    for (size_t i = 0; i < PER_THREAD; i += BATCH) {
+                        const size_t first = v.ReserveSlots(BATCH);
+                        for (size_t j = 0; j < BATCH; ++j) {
+                            v.EmplaceAt(first + j, t, i + j);
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        done = true;
+        reader.join();
+
+        assert(v.Size() == THREADS * PER_THREAD);
+        std::vector<size_t> counts(THREADS * PER_THREAD);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v.IsCommitted(i));
+            ++counts[v[i].first * PER_THREAD + v[i].second];
+        }
+        assert(std::all_of(counts.begin(), counts.end(), [](size_t count) { return count == 1; }));
+    }
+}
+
+void Test27() {
+    const size_t WORKERS = 4;
+    const size_t PER_WORKER = 100000;
+    const ParallelTag policy(WORKERS);
+    {
+        ThreadLocalAppender<int> appender(WORKERS);
+        std::vector<std::thread> workers;
+        for (size_t w = 0; w < WORKERS; ++w) {
+            workers.emplace_back([&appender, w] {
+                for (size_t i = 0; i < PER_WORKER; ++i) {
+                    appender.Local(w).PushBack(static_cast<int>(w * PER_WORKER + i));
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        assert(appender.TotalSize() == WORKERS * PER_WORKER);
+
+        Vector<int> dest;
+        dest.PushBack(-1);
+        appender.MergeInto(dest, policy);
+        assert(dest.Size() == WORKERS * PER_WORKER + 1 && dest.Capacity() == dest.Size());
+        assert(dest[0] == -1);
+        for (size_t i = 0; i < WORKERS * PER_WORKER; ++i) {
+            assert(dest[i + 1] == static_cast<int>(i));
+        }
+        assert(appender.TotalSize() == 0 && appender.Local(0).Capacity() >= PER_WORKER);
+    }
+    {
+        ThreadLocalAppender<std::string> appender(WORKERS);
+        for (size_t w = 0; w < WORKERS; ++w) {
+            appender.Local(w).PushBack(std::string(20, static_cast<char>('a' + w)));
+        }
+        Vector<std::string> dest;
+        appender.MergeInto(dest);
+        assert(dest.Size() == WORKERS && dest[3] == std::string(20, 'd'));
+        appender.MergeInto(dest);
+        assert(dest.Size() == WORKERS);
+    }
+    {
+        ThreadLocalAppender<Cell> appender(WORKERS);
+        Cell::throw_countdown = -1;
+        for (size_t w = 0; w < WORKERS; ++w) {
+            appender.Local(w).Resize(PER_WORKER);
+        }
+        Vector<Cell> dest(10);
+        const int alive = Cell::alive;
+        Cell::throw_countdown = static_cast<int>(PER_WORKER * 2);
+        try {
+            appender.MergeInto(dest, policy);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Cell::throw_countdown = -1;
+        assert(Cell::alive == alive);
+        assert(dest.Size() == 10 && appender.TotalSize() == WORKERS * PER_WORKER);
+        appender.MergeInto(dest, policy);
+        assert(dest.Size() == 10 + WORKERS * PER_WORKER && Cell::alive == alive);
+    }
+    assert(Cell::alive == 0);
+}
+
+void Test28() {
+    {
+        Vector<int> v;
+        v.PushBack(1);
+        v.PushBack(2);
+        const Vector<int>& cv = v;
+        assert(v.At(0) == 1 && cv.At(1) == 2);
+        v.At(1) = 3;
+        assert(v[1] == 3);
+        bool thrown = false;
+        try {
+            cv.At(2);
+        } catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown && v.Size() == 2);
+    }
+    {
+        // Политика проверки не увеличивает размер вектора и не меняет результат корректных обращений
+        using Checked = Vector<int, std::allocator<int>, DoublingGrowth, NoStats, CheckedIndex>;
+        using Sampled = Vector<int, std::allocator<int>, DoublingGrowth, NoStats, SampledIndex<4>>;
+        static_assert(sizeof(Checked) == sizeof(Vector<int>) && sizeof(Sampled) == sizeof(Vector<int>));
+        Checked checked(100);
+        Sampled sampled(100);
+        for (size_t i = 0; i < checked.Size(); ++i) {
+            checked[i] = static_cast<int>(i);
+            sampled[i] = checked[i] * 2;
+        }
+        long sum = 0;
+        for (size_t i = 0; i < sampled.Size(); ++i) {
+            sum += sampled[i] - checked[i];
+        }
+        assert(sum == 99 * 100 / 2);
+        bool thrown = false;
+        try {
+            sampled.At(100);
+        } catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    {
+        SmallVector<int, 2> v;
+        v.PushBack(5);
+        assert(v.At(0) == 5);
+        bool thrown = false;
+        try {
+            v.At(1);
+        } catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+}
+
+// Таблица, которую в C++20 можно построить на этапе компиляции
+template <size_t N>
+ADVANCED_VECTOR_CONSTEXPR std::array<int, N> MakeSquareTable() {
+    Vector<int> squares;
+    for (size_t i = 0; i < N / 2; ++i) {
+        squares.PushBack(static_cast<int>(i * i));
+    }
+    Vector<int> copy(squares);
+    copy.Resize(N);
+    for (size_t i = N / 2; i < N; ++i) {
+        copy[i] = static_cast<int>(i * i);
+    }
+    copy.Reserve(2 * N);
+    std::array<int, N> table{};
+    for (size_t i = 0; i < N; ++i) {
+        table[i] = copy.At(i);
+    }
+    return table;
+}
+
+// Вектор векторов: рост внешнего вектора переносит элементы с собственными буферами
+ADVANCED_VECTOR_CONSTEXPR size_t NestedSize(size_t rows) {
+    Vector<Vector<int>> nested;
+    for (size_t i = 0; i < rows; ++i) {
+        nested.EmplaceBack(i);
+    }
+    Vector<Vector<int>> moved(std::move(nested));
+    size_t total = nested.Size();
+    for (const Vector<int>& row : moved) {
+        total += row.Size();
+    }
+    moved.PopBack();
+    return total + moved.Size();
+}
+
+// Вставки в середину: при свободной ёмкости хвост сдвигается на месте, без неё элементы переносятся
+// в новый буфер. Результат — цифры элементов по порядку и размер вставленного вложенного вектора
+ADVANCED_VECTOR_CONSTEXPR int MiddleInserts() {
+    Vector<int> v;
+    v.Reserve(4);
+    v.PushBack(1);
+    v.PushBack(4);
+    v.Emplace(v.begin() + 1, 2);
+    v.Insert(v.begin() + 2, 3);
+    v.Insert(v.begin() + 1, 9);
+    Vector<Vector<int>> nested;
+    nested.Reserve(3);
+    nested.EmplaceBack(1);
+    nested.EmplaceBack(3);
+    nested.Emplace(nested.begin() + 1, 2);
+    nested.Emplace(nested.begin(), 5);
+    int digits = 0;
+    for (int x : v) {
+        digits = digits * 10 + x;
+    }
+    return digits * 10 + static_cast<int>(nested[0].Size() + nested[2].Size());
+}
+
+void Test29() {
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+    constexpr auto SQUARES = MakeSquareTable<16>();
+    static_assert(SQUARES[3] == 9 && SQUARES[15] == 225);
+    static_assert(NestedSize(10) == 45 + 9);
+    static_assert(MiddleInserts() == 192347);
+#endif
+    assert(MiddleInserts() == 192347);
+    const auto squares = MakeSquareTable<16>();
+    for (size_t i = 0; i < squares.size(); ++i) {
+        assert(squares[i] == static_cast<int>(i * i));
+    }
+    assert(NestedSize(10) == 45 + 9);
+}
+
+// Обобщённый код, написанный для std::vector
+template <typename Container>
+typename Container::value_type SumOfEvenAfterSort(Container& c) {
+    std::sort(c.begin(), c.end());
+    typename Container::value_type sum{};
+    for (typename Container::size_type i = 0; i < c.size(); ++i) {
+        if (c.at(i) % 2 == 0) {
+            sum += c[i];
+        }
+    }
+    return sum;
+}
+
+void Test30() {
+    static_assert(std::is_same_v<Vector<int>::value_type, int>);
+    static_assert(std::is_same_v<std::iterator_traits<Vector<int>::iterator>::iterator_category,
+                                 std::random_access_iterator_tag>);
+#ifdef __cpp_lib_ranges
+    static_assert(std::ranges::contiguous_range<Vector<int>>);
+    static_assert(std::ranges::sized_range<Vector<int>>);
+    static_assert(std::contiguous_iterator<Vector<std::string>::const_iterator>);
+#endif
+    {
+        const std::vector<int> source = {5, 2, 8, 1, 4};
+        Vector<int> v(source.begin(), source.end());
+        std::vector<int> expected = source;
+        assert(SumOfEvenAfterSort(v) == SumOfEvenAfterSort(expected));
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+        assert(v.front() == 1 && v.back() == 8 && v.Front() == v[0] && v.data() == v.Data());
+        assert(!v.empty() && v.size() == 5 && v.capacity() >= 5 && v.max_size() >= v.size());
+        assert(std::accumulate(v.rbegin(), v.rend(), 0) == 20);
+        assert(*v.crbegin() == 8 && *(v.crend() - 1) == 1);
+#ifdef __cpp_lib_ranges
+        std::ranges::sort(v, std::greater<>{});
+        assert(std::ranges::is_sorted(v | std::views::reverse));
+#endif
+    }
+    {
+        using namespace std::literals;
+        Vector<std::string> a(2, "x"s);
+        Vector<std::string> b = a;
+        assert(a == b && !(a != b) && a <= b && a >= b);
+        b.push_back("y"s);
+        assert(a != b && a < b && b > a && a <= b);
+        b.front() = "a";
+        assert(b < a);
+        b.resize(5, b[0]);
+        assert(b.size() == 5 && b[4] == "a");
+        b.erase(b.begin() + 1, b.end());
+        b.insert(b.begin(), "z"s);
+        b.emplace(b.end(), 3, 'w');
+        assert(b.size() == 3 && b[0] == "z" && b[2] == "www");
+        swap(a, b);
+        assert(a.size() == 3 && b.size() == 2);
+        a.assign(4, "q"s);
+        assert(a.size() == 4 && a[3] == "q");
+        a.clear();
+        assert(a.empty());
+    }
+}
+
+void Test31() {
+    {
+        Vector<std::string> v;
+        v.Reserve(3);
+        const std::string* data = v.Data();
+        v.UncheckedEmplaceBack(3, 'a');
+        v.UncheckedEmplaceBack(v[0]);
+        std::string& last = v.UncheckedEmplaceBack("c");
+        assert(v.Data() == data && v.Size() == 3 && &last == &v[2]);
+        // Рост при полном буфере: аргумент ссылается на элемент, который переедет в новый буфер
+        std::string& grown = v.EmplaceBack(v[1]);
+        assert(v.Capacity() > 3 && &grown == &v[3] && grown == "aaa" && v[2] == "c");
+    }
+    {
+        Vector<Cell> v;
+        v.Reserve(1);
+        v.EmplaceBack();
+        Cell::throw_countdown = 1;
+        bool thrown = false;
+        try {
+            v.EmplaceBack();
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        Cell::throw_countdown = 0;
+        assert(thrown && v.Size() == 1 && v.Capacity() == 1);
+    }
+    assert(Cell::alive == 0);
+}
+
+// Сравнение строк, выбрасывающее исключение на заданном по счёту вызове
+struct ThrowingLess {
+    bool operator()(const std::string& lhs, const std::string& rhs) const {
+        if (countdown > 0 && --countdown == 0) {
+            throw std::runtime_error("comparison failure");
+        }
+        return lhs < rhs;
+    }
+
+    static inline int countdown = 0;
+};
+
+struct FlatMapTag {};
+
+void Test32() {
+    {
+        const std::vector<int> source = {5, 3, 9, 3, 1, 5, 7};
+        FlatSet<int> set(source.begin(), source.end());
+        assert(set.Size() == 5 && std::is_sorted(set.begin(), set.end()));
+        assert(set.Contains(9) && !set.Contains(4) && set.Count(3) == 1);
+        assert(*set.LowerBound(4) == 5 && *set.UpperBound(5) == 7 && set.UpperBound(9) == set.end());
+        assert(set.Insert(4).second && !set.Insert(4).second && *set.Insert(0).first == 0);
+        const std::vector<int> more = {8, 2, 8, 4};
+        set.InsertRange(more.begin(), more.end());
+        assert(set.Size() == 9 && std::is_sorted(set.begin(), set.end()));
+        assert(set.Erase(9) == 1 && set.Erase(9) == 0 && *(set.end() - 1) == 8);
+        assert(EraseIf(set, [](int x) { return x % 2 == 0; }) == 4 && set.Size() == 4);
+        FlatSet<int, std::greater<int>> descending(source.begin(), source.end());
+        assert(*descending.begin() == 9 && *descending.LowerBound(4) == 3);
+    }
+    {
+        using namespace std::literals;
+        const std::vector<std::pair<std::string, int>> source = {{"b"s, 1}, {"a"s, 2}, {"b"s, 3}, {"c"s, 4}};
+        FlatMap<std::string, int> map(source.begin(), source.end());
+        assert(map.Size() == 3 && map.At("b") == 1 && map.Keys()[0] == "a");
+        assert(map.Find("z") == nullptr && map.Contains("c"));
+        map["d"] = 5;
+        assert(map.Size() == 4 && *map.Find("d") == 5);
+        assert(!map.Insert("a", 10).second && map.At("a") == 2);
+        assert(map.InsertOrAssign("a", 10) == 10 && map.At("a") == 10);
+        const std::vector<std::pair<std::string, int>> more = {{"e"s, 6}, {"a"s, 0}, {"0"s, 7}};
+        map.InsertRange(more.begin(), more.end());
+        assert(map.Size() == 6 && map.At("a") == 10 && map.At("0") == 7);
+        std::string keys;
+        int total = 0;
+        map.ForEach([&](const std::string& key, int& value) {
+            keys += key;
+            total += value;
+        });
+        assert(keys == "0abcde" && total == 7 + 10 + 1 + 4 + 5 + 6);
+        assert(map.Erase("c") == 1 && map.Erase("c") == 0 && map.Values().Size() == 5);
+        bool thrown = false;
+        try {
+            map.At("c");
+        } catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    {
+        // Сверка со std::map на случайной последовательности операций
+        std::mt19937 rng(42);
+        std::map<int, int> expected;
+        FlatMap<int, int> map;
+        for (int i = 0; i < 2000; ++i) {
+            const int key = static_cast<int>(rng() % 300);
+            if (rng() % 3 == 0) {
+                assert(map.Erase(key) == expected.erase(key));
+            } else {
+                map[key] += i;
+                expected[key] += i;
+            }
+        }
+        assert(map.Size() == expected.size());
+        size_t index = 0;
+        for (const auto& [key, value] : expected) {
+            assert(map.Keys()[index] == key && map.Values()[index] == value);
+            ++index;
+        }
+    }
+    {
+        // Исключение при копировании значения на любом шаге InsertRange не изменяет отображение,
+        // даже если ключи перемещаются без исключений
+        using Value = Instrumented<FlatMapTag, false>;
+        const std::string a(32, 'a'), b(32, 'b'), c(32, 'c'), d(32, 'd'), e(32, 'e');
+        const std::vector<std::pair<std::string, Value>> source = {{a, Value(1)}, {c, Value(3)}, {d, Value(4)}};
+        const std::vector<std::pair<std::string, Value>> more = {{e, Value(5)}, {b, Value(2)}};
+        FlatMap<std::string, Value> map(source.begin(), source.end());
+        bool thrown = true;
+        for (size_t countdown = 1; thrown; ++countdown) {
+            Value::ThrowOnConstruction(countdown);
+            try {
+                map.InsertRange(more.begin(), more.end());
+                thrown = false;
+            } catch (const std::runtime_error&) {
+                assert(map.Size() == 3 && map.Keys()[0] == a && map.Keys()[1] == c && map.Keys()[2] == d);
+                assert(map.At(a).Value() == 1 && map.At(c).Value() == 3 && map.At(d).Value() == 4);
+            }
+        }
+        Value::Reset();
+        assert(map.Size() == 5 && map.Contains(a) && map.At(b).Value() == 2 && map.At(e).Value() == 5);
+    }
+    {
+        // Исключение из компаратора на любом шаге InsertRange не изменяет множество
+        const std::vector<std::string> source = {"d", "a", "c"};
+        const std::vector<std::string> more = {"b", "e", "a"};
+        FlatSet<std::string, ThrowingLess> set(source.begin(), source.end());
+        bool thrown = true;
+        for (int countdown = 1; thrown; ++countdown) {
+            ThrowingLess::countdown = countdown;
+            try {
+                set.InsertRange(more.begin(), more.end());
+                thrown = false;
+            } catch (const std::runtime_error&) {
+                assert(set.Size() == 3 && set.Keys()[0] == "a" && set.Keys()[1] == "c" && set.Keys()[2] == "d");
+            }
+        }
+        ThrowingLess::countdown = 0;
+        assert(set.Size() == 5 && std::is_sorted(set.begin(), set.end()) && set.Contains("e"));
+    }
+}
+
+void Test33() {
+    using Alloc = PoolAllocator<int>;
+    using PooledVector = Vector<int, Alloc>;
+    Alloc::TrimLocal();
+    Alloc::ResetLocalStats();
+    {
+        // Рост в пределах класса размеров выполняется на месте
+        PooledVector v;
+        for (int i = 0; i < 16; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Capacity() == 16 && Alloc::LocalStats().misses == 1);
+    }
+    assert(Alloc::LocalStats().recycled == 1 && Alloc::LocalStats().cached_bytes == 64);
+    for (int i = 0; i < 100; ++i) {
+        PooledVector v;
+        v.Reserve(10 + i % 6);
+        v.Resize(10);
+        assert(v[9] == 0);
+    }
+    {
+        const PoolStats stats = Alloc::LocalStats();
+        assert(stats.misses == 1 && stats.hits == 100 && stats.HitRate() > 0.99);
+        assert(stats.cached_blocks == 1);
+    }
+    {
+        // Буферы, переданные через аллокатор другого типа, попадают в тот же пул
+        Vector<float, PoolAllocator<float>> floats(16);
+        assert(Alloc::LocalStats().hits == 101 && Alloc::LocalStats().cached_blocks == 0);
+    }
+    {
+        std::thread([] {
+            PooledVector v(100);
+            assert(Alloc::LocalStats().misses == 1 && Alloc::LocalStats().hits == 0);
+        }).join();
+        assert(Alloc::LocalStats().hits == 101);
+    }
+    {
+        // Пределы пула: крупные буферы минуют пул, сверх предела объёма буферы возвращаются системе
+        using Small = PoolAllocator<char, 256, 512>;
         {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+            Vector<char, Small> big(1000);
+            Vector<char, Small> a(256);
+            Vector<char, Small> b(256);
+            Vector<char, Small> c(256);
         }
-        Dump();
-    } catch (...) {
+        const PoolStats stats = Small::LocalStats();
+        assert(stats.oversized == 1 && stats.misses == 3 && stats.recycled == 2 && stats.released == 1);
+        assert(stats.cached_bytes == 512);
+        Small::TrimLocal();
+        assert(Small::LocalStats().cached_blocks == 0 && Small::LocalStats().cached_bytes == 0);
     }
+    Alloc::TrimLocal();
 }
 
 int main() {
@@ -648,7 +2514,33 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
     }
@@ -0,0 +1,289 @@
+#pragma once
+#include "vector.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+#include <system_error>
+
+// Аллокаторы, размещающие буферы в отображениях памяти (Linux)
+
+// Размер огромной страницы. Отображения округляются до него, чтобы их можно было целиком
+// покрыть огромными страницами и наращивать через mremap без смены гранулярности
+inline constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+
+namespace detail {
+
+inline size_t RoundUp(size_t bytes, size_t granularity) noexcept {
+    return (bytes + granularity - 1) / granularity * granularity;
+}
+
+// Размер в байтах буфера под n элементов размера element_size. При переполнении выбрасывает bad_alloc
+inline size_t BufferBytes(size_t n, size_t element_size) {
+    if (n > (std::numeric_limits<size_t>::max() - HUGE_PAGE_SIZE) / element_size) {
+        throw std::bad_alloc();
+    }
+    return n * element_size;
+}
+
+// Открытый файл, общий для всех копий FileMappedAllocator
+struct MappedFile {
+    explicit MappedFile(const std::string& path)
+            : fd(open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)) {
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        close(fd);
+    }
+
+    size_t Size() const {
+        struct stat st {};
+        if (fstat(fd, &st) != 0) {
+            throw std::system_error(errno, std::generic_category(), "cannot stat mapped file");
+        }
+        return static_cast<size_t>(st.st_size);
+    }
+
+    void Resize(size_t bytes) const {
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            throw std::bad_alloc();
+        }
+    }
+
+    int fd;
+    // Файл может быть отображён только в один буфер: второй буфер разделял бы с первым те же данные
+    bool mapped = false;
+};
+
+}  // namespace detail
+
+// Аллокатор, выделяющий буферы от ThresholdBytes байт анонимными отображениями с огромными страницами,
+// а меньшие буферы — через malloc, как MallocAllocator. Прозрачные огромные страницы запрашиваются
+// через madvise(MADV_HUGEPAGE); при ExplicitHugePages сначала пробуется MAP_HUGETLB из заранее
+// зарезервированного пула, а если пул пуст — обычное отображение.
+// Большие буферы растут через mremap: ядро переставляет страницы, не копируя данные, а при свободном
+// соседнем адресном пространстве буфер расширяется на месте
+template <typename T, size_t ThresholdBytes = HUGE_PAGE_SIZE, bool ExplicitHugePages = false>
+class MmapAllocator {
+    using SmallAllocator = MallocAllocator<T>;
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = MmapAllocator<U, ThresholdBytes, ExplicitHugePages>;
+    };
+
+    MmapAllocator() = default;
+
+    template <typename U>
+    MmapAllocator(const MmapAllocator<U, ThresholdBytes, ExplicitHugePages>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = detail::BufferBytes(n, sizeof(T));
+        if (!IsMapped(bytes)) {
+            return SmallAllocator().allocate(n);
+        }
+        return static_cast<T*>(Map(MappingSize(bytes)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (IsMapped(bytes)) {
+            munmap(p, MappingSize(bytes));
+        } else {
+            SmallAllocator().deallocate(p, n);
+        }
+    }
+
+    bool try_expand(T* p, size_t old_n, size_t new_n) noexcept {
+        if (new_n > (std::numeric_limits<size_t>::max() - HUGE_PAGE_SIZE) / sizeof(T)) {
+            return false;
+        }
+        const size_t old_bytes = old_n * sizeof(T);
+        const size_t new_bytes = new_n * sizeof(T);
+        if (!IsMapped(old_bytes)) {
+            return !IsMapped(new_bytes) && SmallAllocator().try_expand(p, old_n, new_n);
+        }
+        const size_t old_size = MappingSize(old_bytes);
+        const size_t new_size = MappingSize(new_bytes);
+        return new_size <= old_size || mremap(p, old_size, new_size, 0) != MAP_FAILED;
+    }
+
+    T* reallocate(T* p, size_t old_n, size_t new_n) {
+        if (p == nullptr) {
+            return allocate(new_n);
+        }
+        if (new_n == 0) {
+            deallocate(p, old_n);
+            return nullptr;
+        }
+        const size_t old_bytes = old_n * sizeof(T);
+        const size_t new_bytes = detail::BufferBytes(new_n, sizeof(T));
+        if (IsMapped(old_bytes) && IsMapped(new_bytes)) {
+            void* buf = mremap(p, MappingSize(old_bytes), MappingSize(new_bytes), MREMAP_MAYMOVE);
+            if (buf != MAP_FAILED) {
+                return static_cast<T*>(buf);
+            }
+            // Ядро может отказать в переносе, например отображению MAP_HUGETLB при исчерпанном пуле
+            // огромных страниц: тогда содержимое копируется в новое отображение, как при переходе через порог
+        } else if (!IsMapped(old_bytes) && !IsMapped(new_bytes)) {
+            return SmallAllocator().reallocate(p, old_n, new_n);
+        }
+        // Буфер переходит через порог или не перенесён mremap: содержимое копируется в новый буфер
+        T* buf = allocate(new_n);
+        std::memcpy(static_cast<void*>(buf), p, std::min(old_bytes, new_bytes));
+        deallocate(p, old_n);
+        return buf;
+    }
+
+    template <typename U>
+    bool operator==(const MmapAllocator<U, ThresholdBytes, ExplicitHugePages>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const MmapAllocator<U, ThresholdBytes, ExplicitHugePages>& /*other*/) const noexcept {
+        return false;
+    }
+
+private:
+    static bool IsMapped(size_t bytes) noexcept {
+        return bytes >= ThresholdBytes;
+    }
+
+    static size_t MappingSize(size_t bytes) noexcept {
+        return detail::RoundUp(bytes, HUGE_PAGE_SIZE);
+    }
+
+    static void* Map(size_t size) {
+        if constexpr (ExplicitHugePages) {
+            void* buf = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (buf != MAP_FAILED) {
+                return buf;
+            }
+        }
+        void* buf = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buf == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        // Ядро без поддержки прозрачных огромных страниц отклоняет совет, что не мешает работе буфера
+        madvise(buf, size, MADV_HUGEPAGE);
+        return buf;
+    }
+};
+
+// Аллокатор, размещающий буфер в разделяемом отображении файла: содержимое вектора сохраняется
+// в файле и после перезапуска открывается без чтения и копирования. Длина файла равна ёмкости буфера,
+// поэтому перед закрытием вектор следует сжать через ShrinkToFit; сжатие пустого вектора обрезает
+// файл до нуля. Вектор над существующим файлом
+// создаётся без перезаписи элементов, поэтому элементы должны быть тривиально создаваемыми
+// по умолчанию: инициализаторы членов затёрли бы сохранённые данные:
+//     FileMappedAllocator<Point> alloc("points.bin");
+//     Vector<Point, FileMappedAllocator<Point>> points(alloc.StoredSize(), DEFAULT_INIT, alloc);
+// Один файл может хранить только один буфер: рост, Assign и копирующее присваивание перевыделяют
+// его на месте через reallocate, вектор копируется лишь в вектор с другим аллокатором, а при попытке
+// выделить второй буфер выбрасывается std::bad_alloc
+template <typename T>
+class FileMappedAllocator {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be persisted bytewise");
+    static_assert(std::is_trivially_default_constructible_v<T>,
+                  "default initialization on reopen must not overwrite stored elements");
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit FileMappedAllocator(const std::string& path)
+            : file_(std::make_shared<detail::MappedFile>(path)) {
+    }
+
+    template <typename U>
+    FileMappedAllocator(const FileMappedAllocator<U>& other) noexcept
+            : file_(other.file_) {
+    }
+
+    // Количество элементов, сохранённых в файле
+    size_t StoredSize() const {
+        return file_->Size() / sizeof(T);
+    }
+
+    T* allocate(size_t n) {
+        if (file_->mapped) {
+            throw std::bad_alloc();
+        }
+        const size_t bytes = detail::BufferBytes(n, sizeof(T));
+        file_->Resize(bytes);
+        void* buf = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file_->fd, 0);
+        if (buf == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        file_->mapped = true;
+        return static_cast<T*>(buf);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        munmap(p, n * sizeof(T));
+        file_->mapped = false;
+    }
+
+    T* reallocate(T* p, size_t old_n, size_t new_n) {
+        if (p == nullptr) {
+            return allocate(new_n);
+        }
+        // Сжатие до нуля (ShrinkToFit пустого вектора) освобождает буфер и обрезает файл,
+        // тогда как deallocate при разрушении вектора сохраняет содержимое в файле
+        if (new_n == 0) {
+            deallocate(p, old_n);
+            ftruncate(file_->fd, 0);
+            return nullptr;
+        }
+        const size_t old_bytes = old_n * sizeof(T);
+        const size_t new_bytes = detail::BufferBytes(new_n, sizeof(T));
+        if (new_bytes > old_bytes) {
+            file_->Resize(new_bytes);
+        }
+        void* buf = mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        if (buf == MAP_FAILED) {
+            if (new_bytes > old_bytes) {
+                ftruncate(file_->fd, static_cast<off_t>(old_bytes));
+            }
+            throw std::bad_alloc();
+        }
+        if (new_bytes < old_bytes) {
+            ftruncate(file_->fd, static_cast<off_t>(new_bytes));
+        }
+        return static_cast<T*>(buf);
+    }
+
+    template <typename U>
+    bool operator==(const FileMappedAllocator<U>& other) const noexcept {
+        return file_ == other.file_;
+    }
+
+    template <typename U>
+    bool operator!=(const FileMappedAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    template <typename U>
+    friend class FileMappedAllocator;
+
+    std::shared_ptr<detail::MappedFile> file_;
+};
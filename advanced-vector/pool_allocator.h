@@ -0,0 +1,207 @@
+#pragma once
+#include "vector.h"
+
+// Статистика пула буферов одного потока
+struct PoolStats {
+    size_t hits = 0;           // выделения, обслуженные буфером из пула
+    size_t misses = 0;         // выделения, для которых в пуле не нашлось буфера
+    size_t recycled = 0;       // освобождённые буферы, сохранённые в пуле
+    size_t released = 0;       // освобождённые буферы, возвращённые системе из-за предела пула
+    size_t oversized = 0;      // выделения крупнее наибольшего класса, минующие пул
+    size_t cached_blocks = 0;  // буферов сейчас в пуле
+    size_t cached_bytes = 0;   // их суммарный объём
+
+    double HitRate() const noexcept {
+        const size_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
+namespace detail {
+
+constexpr size_t CeilLog2(size_t x) noexcept {
+    size_t log = 0;
+    while ((size_t{1} << log) < x) {
+        ++log;
+    }
+    return log;
+}
+
+// Пул буферов потока, разбитых на классы размеров MIN_BLOCK_BYTES * 2^k байт вплоть до MaxBlockBytes.
+// Свободные буферы класса образуют односвязный список, звенья которого хранятся в самих буферах.
+// Буферы выделяются глобальным operator new, поэтому буфер, выделенный в одном потоке, можно
+// освободить в другом: он попадёт в пул освобождающего потока
+template <size_t MaxBlockBytes, size_t MaxCachedBytes>
+class BufferPool {
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+public:
+    static constexpr size_t MIN_BLOCK_BYTES = CACHE_LINE_SIZE;
+    static constexpr size_t CLASS_COUNT = CeilLog2(MaxBlockBytes / MIN_BLOCK_BYTES) + 1;
+
+    static_assert(MaxBlockBytes >= MIN_BLOCK_BYTES && (MaxBlockBytes & (MaxBlockBytes - 1)) == 0,
+                  "the largest block size must be a power of two not less than a cache line");
+
+    static constexpr size_t ClassOf(size_t bytes) noexcept {
+        return bytes <= MIN_BLOCK_BYTES ? 0 : CeilLog2(bytes) - CeilLog2(MIN_BLOCK_BYTES);
+    }
+
+    static constexpr size_t ClassBytes(size_t k) noexcept {
+        return MIN_BLOCK_BYTES << k;
+    }
+
+    // Пул вызывающего потока. Состояние пула тривиально разрушаемо и остаётся доступным, пока существует
+    // поток: после завершения деструкторов потоковых объектов пул закрывается и буферы освобождаются напрямую
+    static BufferPool& Local() noexcept {
+        static thread_local Closer closer;
+        static_cast<void>(closer);
+        return local_;
+    }
+
+    void* Take(size_t k) {
+        if (FreeBlock* block = heads_[k]) {
+            heads_[k] = block->next;
+            --stats_.cached_blocks;
+            stats_.cached_bytes -= ClassBytes(k);
+            ++stats_.hits;
+            return block;
+        }
+        void* p = ::operator new(ClassBytes(k));
+        ++stats_.misses;
+        return p;
+    }
+
+    void Give(void* p, size_t k) noexcept {
+        if (closed_ || stats_.cached_bytes + ClassBytes(k) > MaxCachedBytes) {
+            ::operator delete(p);
+            ++stats_.released;
+            return;
+        }
+        heads_[k] = new (p) FreeBlock{heads_[k]};
+        ++stats_.cached_blocks;
+        stats_.cached_bytes += ClassBytes(k);
+        ++stats_.recycled;
+    }
+
+    void CountOversized() noexcept {
+        ++stats_.oversized;
+    }
+
+    // Возвращает системе все буферы пула
+    void Trim() noexcept {
+        for (FreeBlock*& head : heads_) {
+            while (head != nullptr) {
+                ::operator delete(std::exchange(head, head->next));
+            }
+        }
+        stats_.cached_blocks = 0;
+        stats_.cached_bytes = 0;
+    }
+
+    const PoolStats& Stats() const noexcept {
+        return stats_;
+    }
+
+    // Обнуляет счётчики событий, сохраняя сведения о буферах в пуле
+    void ResetStats() noexcept {
+        stats_ = {0, 0, 0, 0, 0, stats_.cached_blocks, stats_.cached_bytes};
+    }
+
+private:
+    struct Closer {
+        ~Closer() {
+            local_.Trim();
+            local_.closed_ = true;
+        }
+    };
+
+    static thread_local BufferPool local_;
+
+    FreeBlock* heads_[CLASS_COUNT] = {};
+    PoolStats stats_;
+    bool closed_ = false;
+};
+
+template <size_t MaxBlockBytes, size_t MaxCachedBytes>
+thread_local BufferPool<MaxBlockBytes, MaxCachedBytes> BufferPool<MaxBlockBytes, MaxCachedBytes>::local_;
+
+}  // namespace detail
+
+// Аллокатор, возвращающий освобождённые буферы в пул потока вместо системы: контейнеры, которые
+// часто создаются и разрушаются с похожими ёмкостями, получают буферы из пула без обращения к malloc.
+// Запросы округляются вверх до класса размеров (степени двойки от строки кэша), поэтому рост
+// в пределах класса выполняется на месте через try_expand. Буферы крупнее MaxBlockBytes минуют пул,
+// а пул одного потока хранит не более MaxCachedBytes байт; остальные буферы возвращаются системе.
+// Аллокаторы с одинаковыми пределами используют один пул независимо от типа элементов
+template <typename T, size_t MaxBlockBytes = size_t{1} << 20, size_t MaxCachedBytes = size_t{8} << 20>
+class PoolAllocator {
+    using Pool = detail::BufferPool<MaxBlockBytes, MaxCachedBytes>;
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U, MaxBlockBytes, MaxCachedBytes>;
+    };
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U, MaxBlockBytes, MaxCachedBytes>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned types are not supported");
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(T);
+        if (bytes > MaxBlockBytes) {
+            Pool::Local().CountOversized();
+            return static_cast<T*>(::operator new(bytes));
+        }
+        return static_cast<T*>(Pool::Local().Take(Pool::ClassOf(bytes)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (bytes > MaxBlockBytes) {
+            ::operator delete(p);
+        } else {
+            Pool::Local().Give(p, Pool::ClassOf(bytes));
+        }
+    }
+
+    // Блок из пула занимает весь свой класс, поэтому расширяется на месте, пока помещается в него
+    bool try_expand(T* /*p*/, size_t old_n, size_t new_n) noexcept {
+        const size_t old_bytes = old_n * sizeof(T);
+        return old_bytes <= MaxBlockBytes && new_n <= Pool::ClassBytes(Pool::ClassOf(old_bytes)) / sizeof(T);
+    }
+
+    // Статистика и обслуживание пула вызывающего потока
+    static PoolStats LocalStats() noexcept {
+        return Pool::Local().Stats();
+    }
+
+    static void ResetLocalStats() noexcept {
+        Pool::Local().ResetStats();
+    }
+
+    static void TrimLocal() noexcept {
+        Pool::Local().Trim();
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U, MaxBlockBytes, MaxCachedBytes>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U, MaxBlockBytes, MaxCachedBytes>&) const noexcept {
+        return false;
+    }
+};
@@ -0,0 +1,362 @@
+#pragma once
+#include "vector.h"
+
+namespace detail {
+
+// Наибольшая степень двойки, при которой блок занимает не больше 4 КиБ, но не меньше одного элемента
+template <typename T>
+constexpr size_t DefaultChunkCapacity() {
+    size_t capacity = 1;
+    while (capacity * 2 * sizeof(T) <= 4096) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+}  // namespace detail
+
+// Вектор из блоков фиксированной ёмкости ChunkCapacity. Рост добавляет новый блок и никогда не переносит
+// элементы, поэтому адреса элементов стабильны до их удаления, а добавление в конец не вызывает
+// O(n)-переносов. Доступ по индексу выполняется за O(1) сдвигом и маской, внутри блока элементы
+// лежат подряд: итераторы переходят к следующему блоку только на его границе, а блоки целиком
+// доступны через ChunkCount/ChunkData/ChunkSize
+template <typename T, size_t ChunkCapacity = detail::DefaultChunkCapacity<T>(), typename Allocator = std::allocator<T>>
+class SegmentedVector {
+    static_assert(ChunkCapacity != 0 && (ChunkCapacity & (ChunkCapacity - 1)) == 0,
+                  "chunk capacity must be a power of two");
+
+    using Chunk = RawMemory<T, Allocator>;
+    using ChunkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+
+    static constexpr size_t CHUNK_SHIFT = [] {
+        size_t shift = 0;
+        while ((size_t{1} << shift) != ChunkCapacity) {
+            ++shift;
+        }
+        return shift;
+    }();
+    static constexpr size_t CHUNK_MASK = ChunkCapacity - 1;
+
+public:
+    template <bool IsConst>
+    class BasicIterator {
+        using Owner = std::conditional_t<IsConst, const SegmentedVector, SegmentedVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        BasicIterator() = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+                : owner_(owner)
+                , index_(index) {
+            Locate();
+        }
+
+        operator BasicIterator<true>() const noexcept {
+            return {owner_, index_};
+        }
+
+        reference operator*() const noexcept {
+            return *ptr_;
+        }
+
+        pointer operator->() const noexcept {
+            return ptr_;
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return (*owner_)[index_ + offset];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            if (++ptr_ == chunk_end_) {
+                Locate();
+            }
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            Locate();
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            auto copy = *this;
+            --*this;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            Locate();
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            return *this += -offset;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        bool operator==(const BasicIterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const BasicIterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+        bool operator<(const BasicIterator& other) const noexcept {
+            return index_ < other.index_;
+        }
+
+        bool operator>(const BasicIterator& other) const noexcept {
+            return other < *this;
+        }
+
+        bool operator<=(const BasicIterator& other) const noexcept {
+            return !(other < *this);
+        }
+
+        bool operator>=(const BasicIterator& other) const noexcept {
+            return !(*this < other);
+        }
+
+    private:
+        // Находит блок текущего индекса. Итератор за последним элементом указывает в начало
+        // следующего блока, который может ещё не существовать
+        void Locate() noexcept {
+            const size_t chunk = index_ >> CHUNK_SHIFT;
+            if (chunk < owner_->chunks_.Size()) {
+                ptr_ = owner_->chunks_[chunk].GetAddress() + (index_ & CHUNK_MASK);
+                chunk_end_ = owner_->chunks_[chunk].GetAddress() + ChunkCapacity;
+            } else {
+                ptr_ = nullptr;
+                chunk_end_ = nullptr;
+            }
+        }
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+        pointer ptr_ = nullptr;
+        pointer chunk_end_ = nullptr;
+
+        template <bool>
+        friend class BasicIterator;
+    };
+
+    using allocator_type = Allocator;
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    static constexpr size_t CHUNK_CAPACITY = ChunkCapacity;
+
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(const Allocator& alloc) noexcept
+            : alloc_(alloc)
+            , chunks_(ChunkAllocator(alloc)) {
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+            : SegmentedVector(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.alloc_))
+    {
+        Reserve(other.size_);
+        for (const T& value : other) {
+            EmplaceBack(value);
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+            : alloc_(other.alloc_)
+            , chunks_(std::move(other.chunks_))
+            , size_(std::exchange(other.size_, 0)) {
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            SegmentedVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    void Swap(SegmentedVector& other) noexcept {
+        std::swap(alloc_, other.alloc_);
+        chunks_.Swap(other.chunks_);
+        std::swap(size_, other.size_);
+    }
+
+    allocator_type GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return chunks_.Size() * ChunkCapacity;
+    }
+
+    // Выделяет блоки, необходимые для хранения new_capacity элементов. Элементы не переносятся
+    void Reserve(size_t new_capacity) {
+        const size_t chunk_count = (new_capacity + CHUNK_MASK) >> CHUNK_SHIFT;
+        chunks_.Reserve(chunk_count);
+        while (chunks_.Size() < chunk_count) {
+            chunks_.EmplaceBack(ChunkCapacity, alloc_);
+        }
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Аргументы могут ссылаться на элементы самого вектора: добавление блока их не перемещает
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            chunks_.EmplaceBack(ChunkCapacity, alloc_);
+        }
+        T* slot = chunks_[size_ >> CHUNK_SHIFT].GetAddress() + (size_ & CHUNK_MASK);
+        new (slot) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        std::destroy_at(&(*this)[size_ - 1]);
+        --size_;
+    }
+
+    // Уничтожает все элементы, сохраняя выделенные блоки
+    void Clear() noexcept {
+        ForEachChunk([](T* data, size_t size) {
+            std::destroy_n(data, size);
+        });
+        size_ = 0;
+    }
+
+    // Освобождает блоки, в которых не осталось элементов
+    void ShrinkToFit() {
+        const size_t chunk_count = (size_ + CHUNK_MASK) >> CHUNK_SHIFT;
+        while (chunks_.Size() > chunk_count) {
+            chunks_.PopBack();
+        }
+        chunks_.ShrinkToFit();
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return chunks_[index >> CHUNK_SHIFT].GetAddress()[index & CHUNK_MASK];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    // Количество блоков, содержащих элементы
+    size_t ChunkCount() const noexcept {
+        return (size_ + CHUNK_MASK) >> CHUNK_SHIFT;
+    }
+
+    T* ChunkData(size_t chunk) noexcept {
+        assert(chunk < ChunkCount());
+        return chunks_[chunk].GetAddress();
+    }
+
+    const T* ChunkData(size_t chunk) const noexcept {
+        return const_cast<SegmentedVector&>(*this).ChunkData(chunk);
+    }
+
+    // Количество элементов в блоке: ChunkCapacity во всех блоках, кроме последнего
+    size_t ChunkSize(size_t chunk) const noexcept {
+        assert(chunk < ChunkCount());
+        return std::min(size_ - (chunk << CHUNK_SHIFT), ChunkCapacity);
+    }
+
+    // Вызывает func(data, size) для каждого непрерывного блока элементов
+    template <typename Func>
+    void ForEachChunk(Func func) {
+        for (size_t chunk = 0, count = ChunkCount(); chunk != count; ++chunk) {
+            func(ChunkData(chunk), ChunkSize(chunk));
+        }
+    }
+
+    template <typename Func>
+    void ForEachChunk(Func func) const {
+        for (size_t chunk = 0, count = ChunkCount(); chunk != count; ++chunk) {
+            func(ChunkData(chunk), ChunkSize(chunk));
+        }
+    }
+
+    iterator begin() noexcept {
+        return {this, 0};
+    }
+
+    iterator end() noexcept {
+        return {this, size_};
+    }
+
+    const_iterator begin() const noexcept {
+        return {this, 0};
+    }
+
+    const_iterator end() const noexcept {
+        return {this, size_};
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    ~SegmentedVector() {
+        Clear();
+    }
+
+private:
+    [[no_unique_address]] Allocator alloc_;
+    Vector<Chunk, ChunkAllocator> chunks_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include "vector.h"
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+// Сохранение и загрузка векторов тривиально копируемых элементов (POSIX). Формат — заголовок
+// SerializedVectorHeader, за которым следуют байты элементов в представлении текущей платформы,
+// поэтому данные переносимы только между машинами с одинаковыми порядком байтов и раскладкой T
+
+inline constexpr uint32_t SERIALIZED_VECTOR_MAGIC = 0x43455641;  // "AVEC"
+
+struct SerializedVectorHeader {
+    uint32_t magic = SERIALIZED_VECTOR_MAGIC;
+    uint32_t element_size = 0;
+    uint64_t count = 0;
+    uint32_t alignment = 0;
+    uint32_t reserved = 0;
+};
+
+namespace detail {
+
+// Записывает все буферы iov, продолжая после частичной записи и прерываний сигналами
+inline void WriteAll(int fd, iovec* iov, int count) {
+    while (count != 0) {
+        const ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "writev failed");
+        }
+        size_t rest = static_cast<size_t>(written);
+        while (count != 0 && rest >= iov->iov_len) {
+            rest -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count != 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + rest;
+            iov->iov_len -= rest;
+        }
+    }
+}
+
+// Читает ровно size байт. Конец данных до их получения считается ошибкой формата
+inline void ReadAll(int fd, void* data, size_t size) {
+    char* dst = static_cast<char*>(data);
+    while (size != 0) {
+        const ssize_t received = read(fd, dst, size);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "read failed");
+        }
+        if (received == 0) {
+            throw std::runtime_error("unexpected end of serialized vector");
+        }
+        dst += received;
+        size -= static_cast<size_t>(received);
+    }
+}
+
+}  // namespace detail
+
+// Записывает заголовок и элементы вектора одним вызовом writev, не обходя элементы
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename BoundsCheck>
+void WriteVector(int fd, const Vector<T, Allocator, GrowthPolicy, StatsPolicy, BoundsCheck>& v) {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be serialized bytewise");
+    SerializedVectorHeader header;
+    header.element_size = sizeof(T);
+    header.count = v.Size();
+    header.alignment = alignof(T);
+    iovec iov[2] = {
+        {&header, sizeof(header)},
+        {const_cast<std::byte*>(v.Bytes()), v.ByteSize()},
+    };
+    detail::WriteAll(fd, iov, v.Size() != 0 ? 2 : 1);
+}
+
+// Читает вектор, записанный WriteVector. Байты элементов читаются прямо в буфер нового вектора,
+// элементы не инициализируются перед чтением. Если размер или выравнивание элементов в заголовке
+// не совпадают с T, выбрасывается std::runtime_error
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth,
+          typename StatsPolicy = NoStats, typename BoundsCheck = DefaultBoundsCheck>
+Vector<T, Allocator, GrowthPolicy, StatsPolicy, BoundsCheck> ReadVector(int fd, const Allocator& alloc = Allocator()) {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be serialized bytewise");
+    SerializedVectorHeader header;
+    detail::ReadAll(fd, &header, sizeof(header));
+    if (header.magic != SERIALIZED_VECTOR_MAGIC) {
+        throw std::runtime_error("not a serialized vector");
+    }
+    if (header.element_size != sizeof(T) || header.alignment != alignof(T)) {
+        throw std::runtime_error("serialized vector has a different element type");
+    }
+    if (header.count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+        throw std::runtime_error("serialized vector is too large");
+    }
+    Vector<T, Allocator, GrowthPolicy, StatsPolicy, BoundsCheck> v(static_cast<size_t>(header.count), DEFAULT_INIT, alloc);
+    detail::ReadAll(fd, v.Bytes(), v.ByteSize());
+    return v;
+}
@@ -0,0 +1,290 @@
+#pragma once
+#include "vector.h"
+
+// Контейнер со стабильными индексами: элементы никогда не сдвигаются, а освободившиеся ячейки
+// объединяются в список свободных и переиспользуются следующими вставками.
+// Вставка и удаление выполняются за O(1), индекс элемента не меняется до его удаления.
+// Адреса элементов стабильны только до очередного роста ёмкости
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class SlotVector {
+    struct Slot {
+        Slot() noexcept {
+        }
+
+        ~Slot() {
+        }
+
+        union {
+            T value;
+            size_t next_free;
+        };
+        bool occupied = false;
+    };
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using Ops = detail::ElementOps<T>;
+
+    // Признак конца списка свободных ячеек
+    static constexpr size_t NO_SLOT = std::numeric_limits<size_t>::max();
+
+public:
+    template <bool IsConst>
+    class BasicIterator {
+        using SlotPtr = std::conditional_t<IsConst, const Slot*, Slot*>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        BasicIterator() = default;
+
+        BasicIterator(SlotPtr slot, SlotPtr end) noexcept
+                : slot_(slot)
+                , end_(end) {
+            SkipFree();
+        }
+
+        operator BasicIterator<true>() const noexcept {
+            return {slot_, end_};
+        }
+
+        reference operator*() const noexcept {
+            return slot_->value;
+        }
+
+        pointer operator->() const noexcept {
+            return &slot_->value;
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++slot_;
+            SkipFree();
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const BasicIterator& other) const noexcept {
+            return slot_ == other.slot_;
+        }
+
+        bool operator!=(const BasicIterator& other) const noexcept {
+            return slot_ != other.slot_;
+        }
+
+    private:
+        void SkipFree() noexcept {
+            while (slot_ != end_ && !slot_->occupied) {
+                ++slot_;
+            }
+        }
+
+        SlotPtr slot_ = nullptr;
+        SlotPtr end_ = nullptr;
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    SlotVector() = default;
+
+    explicit SlotVector(const Allocator& alloc) noexcept
+            : slots_(SlotAllocator(alloc)) {
+    }
+
+    SlotVector(const SlotVector&) = delete;
+    SlotVector& operator=(const SlotVector&) = delete;
+
+    SlotVector(SlotVector&& other) noexcept
+            : slots_(std::move(other.slots_))
+            , used_(std::exchange(other.used_, 0))
+            , size_(std::exchange(other.size_, 0))
+            , free_head_(std::exchange(other.free_head_, NO_SLOT)) {
+    }
+
+    SlotVector& operator=(SlotVector&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    void Swap(SlotVector& other) noexcept {
+        slots_.Swap(other.slots_);
+        std::swap(used_, other.used_);
+        std::swap(size_, other.size_);
+        std::swap(free_head_, other.free_head_);
+    }
+
+    // Количество элементов
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    // Количество ячеек, из которых можно вставлять без роста: занятые, свободные и ни разу не использованные
+    size_t Capacity() const noexcept {
+        return slots_.Capacity();
+    }
+
+    // Граница используемых индексов: все индексы элементов меньше этого значения
+    size_t SlotCount() const noexcept {
+        return used_;
+    }
+
+    bool Contains(size_t index) const noexcept {
+        return index < used_ && slots_[index].occupied;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > slots_.Capacity()) {
+            Grow(new_capacity);
+        }
+    }
+
+    // Создаёт элемент в свободной ячейке и возвращает его индекс
+    template <typename... Args>
+    size_t Emplace(Args&&... args) {
+        if (free_head_ != NO_SLOT) {
+            const size_t index = free_head_;
+            Slot& slot = slots_[index];
+            // Конструктор T пишет поверх звена списка свободных ячеек: при исключении звено восстанавливается
+            const size_t next_free = slot.next_free;
+            try {
+                new (&slot.value) T(std::forward<Args>(args)...);
+            } catch (...) {
+                slot.next_free = next_free;
+                throw;
+            }
+            slot.occupied = true;
+            free_head_ = next_free;
+            ++size_;
+            return index;
+        }
+        if (used_ == slots_.Capacity()) {
+            // Аргументы могут ссылаться на элементы, которые переедут при росте
+            T tmp(std::forward<Args>(args)...);
+            Grow(GrowthPolicy::NextCapacity(slots_.Capacity(), used_ + 1, sizeof(Slot)));
+            return EmplaceAtEnd(std::move(tmp));
+        }
+        return EmplaceAtEnd(std::forward<Args>(args)...);
+    }
+
+    size_t Insert(const T& value) {
+        return Emplace(value);
+    }
+
+    size_t Insert(T&& value) {
+        return Emplace(std::move(value));
+    }
+
+    // Удаляет элемент по индексу. Индекс может быть выдан повторно следующей вставкой
+    void Erase(size_t index) noexcept {
+        assert(Contains(index));
+        Slot& slot = slots_[index];
+        std::destroy_at(&slot.value);
+        slot.occupied = false;
+        slot.next_free = free_head_;
+        free_head_ = index;
+        --size_;
+    }
+
+    void Clear() noexcept {
+        DestroyAll();
+        used_ = 0;
+        size_ = 0;
+        free_head_ = NO_SLOT;
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(Contains(index));
+        return slots_[index].value;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SlotVector&>(*this)[index];
+    }
+
+    iterator begin() noexcept {
+        return {slots_.GetAddress(), slots_.GetAddress() + used_};
+    }
+
+    iterator end() noexcept {
+        return {slots_.GetAddress() + used_, slots_.GetAddress() + used_};
+    }
+
+    const_iterator begin() const noexcept {
+        return {slots_.GetAddress(), slots_.GetAddress() + used_};
+    }
+
+    const_iterator end() const noexcept {
+        return {slots_.GetAddress() + used_, slots_.GetAddress() + used_};
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    ~SlotVector() {
+        DestroyAll();
+    }
+
+private:
+    template <typename... Args>
+    size_t EmplaceAtEnd(Args&&... args) {
+        Slot* slot = new (slots_ + used_) Slot();
+        new (&slot->value) T(std::forward<Args>(args)...);
+        slot->occupied = true;
+        ++size_;
+        return used_++;
+    }
+
+    // Переносит ячейки в новый буфер. При исключении исходный буфер не изменяется
+    void Grow(size_t new_capacity) {
+        RawMemory<Slot, SlotAllocator> new_slots(new_capacity, slots_.GetAllocator());
+        size_t moved = 0;
+        try {
+            for (; moved != used_; ++moved) {
+                Slot* dst = new (new_slots + moved) Slot();
+                const Slot& src = slots_[moved];
+                if (src.occupied) {
+                    Ops::MoveOrCopyN(&slots_[moved].value, 1, &dst->value);
+                    dst->occupied = true;
+                } else {
+                    dst->next_free = src.next_free;
+                }
+            }
+        } catch (...) {
+            for (size_t i = 0; i != moved; ++i) {
+                if (new_slots[i].occupied) {
+                    std::destroy_at(&new_slots[i].value);
+                }
+            }
+            throw;
+        }
+        DestroyAll();
+        slots_.Swap(new_slots);
+    }
+
+    void DestroyAll() noexcept {
+        for (size_t i = 0; i != used_; ++i) {
+            if (slots_[i].occupied) {
+                std::destroy_at(&slots_[i].value);
+            }
+        }
+    }
+
+    RawMemory<Slot, SlotAllocator> slots_;
+    // Число ячеек, которые хотя бы раз были заняты
+    size_t used_ = 0;
+    size_t size_ = 0;
+    size_t free_head_ = NO_SLOT;
+};
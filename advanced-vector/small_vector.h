@@ -0,0 +1,257 @@
+#pragma once
+#include "vector.h"
+
+// Вектор, хранящий до N элементов во встроенном буфере внутри самого объекта и переходящий
+// в динамическую память, только когда элементы перестают туда помещаться.
+// Обратно во встроенный буфер элементы не возвращаются.
+// Размещение элементов выполняется теми же алгоритмами, что и в Vector, с той же строгой
+// гарантией безопасности исключений
+template <typename T, size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class SmallVector {
+    static_assert(N > 0, "inline capacity must be positive");
+
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using Ops = detail::ElementOps<T>;
+
+public:
+    using allocator_type = Allocator;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_t INLINE_CAPACITY = N;
+
+    SmallVector() = default;
+
+    explicit SmallVector(const Allocator& alloc) noexcept
+            : heap_(alloc) {
+    }
+
+    explicit SmallVector(size_t size, const Allocator& alloc = Allocator())
+            : heap_(alloc)
+    {
+        Reserve(size);
+        std::uninitialized_value_construct_n(Data(), size);
+        size_ = size;
+    }
+
+    SmallVector(const SmallVector& other)
+            : SmallVector(other, AllocTraits::select_on_container_copy_construction(other.heap_.GetAllocator()))
+    {
+    }
+
+    SmallVector(const SmallVector& other, const Allocator& alloc)
+            : heap_(alloc)
+    {
+        Reserve(other.size_);
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    // Динамический буфер забирается целиком, элементы встроенного буфера переносятся по одному
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : heap_(other.heap_.GetAllocator())
+    {
+        if (other.IsInline()) {
+            Ops::RelocateN(other.Data(), other.size_, Data());
+        } else {
+            heap_.Swap(other.heap_);
+        }
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    SmallVector& operator=(const SmallVector& rhs) {
+        if (this != &rhs) {
+            if (rhs.size_ > Capacity()) {
+                SmallVector rhs_copy(rhs, heap_.GetAllocator());
+                *this = std::move(rhs_copy);
+            } else {
+                std::copy(rhs.Data(), rhs.Data() + std::min(rhs.size_, size_), Data());
+                if(rhs.size_ <= size_) {
+                    std::destroy_n(Data() + rhs.size_, size_ - rhs.size_);
+                } else {
+                    std::uninitialized_copy_n(rhs.Data() + size_, rhs.size_ - size_, Data() + size_);
+                }
+                size_ = rhs.size_;
+            }
+        }
+        return *this;
+    }
+
+    // Аллокатор не распространяется: при неравных аллокаторах элементы переносятся по одному
+    SmallVector& operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>
+                                                       && AllocTraits::is_always_equal::value) {
+        if (this != &rhs) {
+            std::destroy_n(Data(), size_);
+            size_ = 0;
+            if (!rhs.IsInline() && heap_.GetAllocator() == rhs.heap_.GetAllocator()) {
+                RawMemory<T, Allocator> released(heap_.GetAllocator());
+                heap_.Swap(released);
+                heap_.Swap(rhs.heap_);
+            } else {
+                Reserve(rhs.size_);
+                Ops::RelocateN(rhs.Data(), rhs.size_, Data());
+            }
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    void Swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>
+                                           && AllocTraits::is_always_equal::value) {
+        SmallVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    allocator_type GetAllocator() const noexcept {
+        return heap_.GetAllocator();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return IsInline() ? N : heap_.Capacity();
+    }
+
+    // Элементы размещены во встроенном буфере, динамическая память не используется
+    bool IsInline() const noexcept {
+        return heap_.Capacity() == 0;
+    }
+
+    void Resize(size_t new_size) {
+        if(size_ == new_size) {
+            return;
+        }
+        if(new_size < size_) {
+            std::destroy(Data() + new_size, Data() + size_);
+        } else {
+            Reserve(new_size);
+            std::uninitialized_value_construct(Data() + size_, Data() + new_size);
+        }
+        size_ = new_size;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        return *Emplace(end(), std::forward<Args>(args)...);
+    }
+
+    void PopBack() {
+        assert(size_ != 0);
+        std::destroy_at(Data() + size_ - 1);
+        --size_;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        RawMemory<T, Allocator> new_data(new_capacity, heap_.GetAllocator());
+        Ops::RelocateN(Data(), size_, new_data.GetAddress());
+        heap_.Swap(new_data);
+    }
+
+    iterator begin() noexcept {
+        return Data();
+    }
+
+    iterator end() noexcept {
+        return Data() + size_;
+    }
+
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+
+    const_iterator end() const noexcept {
+        return Data() + size_;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        const size_t index = pos - begin();
+        if (size_ < Capacity()) {
+            Ops::InsertWithoutReallocation(Data(), size_, index, std::forward<Args>(args)...);
+        } else {
+            RawMemory<T, Allocator> new_data(GrowthPolicy::NextCapacity(Capacity(), size_ + 1, sizeof(T)),
+                                             heap_.GetAllocator());
+            Ops::InsertIntoBuffer(Data(), size_, index, new_data.GetAddress(), std::forward<Args>(args)...);
+            heap_.Swap(new_data);
+        }
+        ++size_;
+        return Data() + index;
+    }
+
+    iterator Erase(const_iterator pos) {
+        assert(pos >= begin() && pos < end());
+        const size_t index = pos - begin();
+        Ops::Erase(Data(), size_, index);
+        --size_;
+        return Data() + index;
+    }
+
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SmallVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        DefaultBoundsCheck::Check(index, size_);
+        return Data()[index];
+    }
+
+    // Доступ с проверкой индекса: выбрасывает std::out_of_range
+    const T& At(size_t index) const {
+        return const_cast<SmallVector&>(*this).At(index);
+    }
+
+    T& At(size_t index) {
+        if (ADVANCED_VECTOR_UNLIKELY(index >= size_)) {
+            throw std::out_of_range("SmallVector::At: index out of range");
+        }
+        return Data()[index];
+    }
+
+    ~SmallVector() {
+        std::destroy_n(Data(), size_);
+    }
+
+private:
+    T* Data() noexcept {
+        return IsInline() ? reinterpret_cast<T*>(inline_) : heap_.GetAddress();
+    }
+
+    const T* Data() const noexcept {
+        return const_cast<SmallVector&>(*this).Data();
+    }
+
+    RawMemory<T, Allocator> heap_;
+    size_t size_ = 0;
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+};
@@ -0,0 +1,303 @@
+#pragma once
+#include "vector.h"
+
+#include <tuple>
+
+// Непрерывный диапазон элементов одного столбца
+template <typename T>
+class ColumnSpan {
+public:
+    ColumnSpan(T* data, size_t size) noexcept
+            : data_(data)
+            , size_(size) {
+    }
+
+    T* Data() const noexcept {
+        return data_;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    T* begin() const noexcept {
+        return data_;
+    }
+
+    T* end() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+// Вектор строк из полей Fields..., хранящий каждое поле в отдельном столбце: цикл, которому нужны
+// только некоторые поля, читает лишь их столбцы. Столбцы выровнены по строке кэша и имеют общие
+// размер и ёмкость. Строка доступна как кортеж ссылок на её поля:
+//     SoAVector<float, float, int> particles;
+//     particles.EmplaceBack(1.0f, 2.0f, 3);
+//     auto [x, y, id] = particles[0];
+//     for (float& x : particles.Column<0>()) { ... }
+// Перенос строк при росте выполняется алгоритмами Vector: тривиально релоцируемые столбцы
+// переносятся memcpy, а если копирование какого-либо столбца выбрасывает исключение, вектор не изменяется
+template <typename... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "at least one field is required");
+
+    template <typename F>
+    using ColumnMemory = RawMemory<F, AlignedAllocator<F>>;
+    using Columns = std::tuple<ColumnMemory<Fields>...>;
+    using Indices = std::index_sequence_for<Fields...>;
+
+    template <typename F>
+    static constexpr bool IsNothrowRelocatable = IsTriviallyRelocatableV<F> || std::is_nothrow_move_constructible_v<F>;
+
+public:
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+    using Reference = std::tuple<Fields&...>;
+    using ConstReference = std::tuple<const Fields&...>;
+
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+
+    SoAVector() = default;
+
+    explicit SoAVector(size_t size)
+            : columns_(ColumnMemory<Fields>(size)...)
+    {
+        ConstructRows(0, size);
+        size_ = size;
+    }
+
+    SoAVector(const SoAVector& other)
+            : columns_(ColumnMemory<Fields>(other.size_)...)
+    {
+        ForEachColumnWithRollback(
+                [this, &other](auto i) {
+                    constexpr size_t I = decltype(i)::value;
+                    detail::ElementOps<FieldType<I>>::CopyN(std::get<I>(other.columns_).GetAddress(), other.size_,
+                                                            std::get<I>(columns_).GetAddress());
+                },
+                [this, &other](auto i) noexcept {
+                    std::destroy_n(std::get<decltype(i)::value>(columns_).GetAddress(), other.size_);
+                });
+        size_ = other.size_;
+    }
+
+    SoAVector(SoAVector&& other) noexcept
+            : columns_(std::move(other.columns_))
+            , size_(std::exchange(other.size_, 0)) {
+    }
+
+    SoAVector& operator=(const SoAVector& rhs) {
+        if (this != &rhs) {
+            SoAVector rhs_copy(rhs);
+            Swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    SoAVector& operator=(SoAVector&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    void Swap(SoAVector& other) noexcept {
+        ForEachColumn([this, &other](auto i) {
+            std::get<decltype(i)::value>(columns_).Swap(std::get<decltype(i)::value>(other.columns_));
+        });
+        std::swap(size_, other.size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return std::get<0>(columns_).Capacity();
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        Columns new_columns{ColumnMemory<Fields>(new_capacity)...};
+        RelocateInto(new_columns);
+        SwapColumns(new_columns);
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyRows(columns_, new_size, size_ - new_size);
+        } else if (new_size > size_) {
+            Reserve(new_size);
+            ConstructRows(size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    // Добавляет строку, создавая каждое поле из соответствующего аргумента. Аргументы могут ссылаться
+    // на поля самого вектора: при росте строка создаётся в новых столбцах до переноса остальных строк
+    template <typename... Args>
+    Reference EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "one argument per field is required");
+        if (size_ == Capacity()) {
+            const size_t new_capacity = DoublingGrowth::NextCapacity(Capacity(), size_ + 1, (sizeof(Fields) + ...));
+            Columns new_columns{ColumnMemory<Fields>(new_capacity)...};
+            ConstructRow(new_columns, std::forward<Args>(args)...);
+            try {
+                RelocateInto(new_columns);
+            } catch (...) {
+                DestroyRows(new_columns, size_, 1);
+                throw;
+            }
+            SwapColumns(new_columns);
+        } else {
+            ConstructRow(columns_, std::forward<Args>(args)...);
+        }
+        ++size_;
+        return (*this)[size_ - 1];
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        DestroyRows(columns_, size_ - 1, 1);
+        --size_;
+    }
+
+    void Clear() noexcept {
+        DestroyRows(columns_, 0, size_);
+        size_ = 0;
+    }
+
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return RowAt<Reference>(*this, index, Indices{});
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return RowAt<ConstReference>(*this, index, Indices{});
+    }
+
+    template <size_t I>
+    ColumnSpan<FieldType<I>> Column() noexcept {
+        return {std::get<I>(columns_).GetAddress(), size_};
+    }
+
+    template <size_t I>
+    ColumnSpan<const FieldType<I>> Column() const noexcept {
+        return {std::get<I>(columns_).GetAddress(), size_};
+    }
+
+    ~SoAVector() {
+        Clear();
+    }
+
+private:
+    template <typename Func>
+    static void ForEachColumn(Func&& func) {
+        ForEachColumnImpl(func, Indices{});
+    }
+
+    template <typename Func, size_t... Is>
+    static void ForEachColumnImpl(Func& func, std::index_sequence<Is...>) {
+        (func(std::integral_constant<size_t, Is>{}), ...);
+    }
+
+    // Вызывает construct(i) для столбцов начиная с I. Если столбец выбрасывает исключение,
+    // для уже обработанных столбцов в обратном порядке вызывается rollback(i)
+    template <size_t I = 0, typename Construct, typename Rollback>
+    static void ForEachColumnWithRollback(Construct&& construct, Rollback&& rollback) {
+        if constexpr (I < sizeof...(Fields)) {
+            construct(std::integral_constant<size_t, I>{});
+            try {
+                ForEachColumnWithRollback<I + 1>(construct, rollback);
+            } catch (...) {
+                rollback(std::integral_constant<size_t, I>{});
+                throw;
+            }
+        }
+    }
+
+    template <typename Row, typename Self, size_t... Is>
+    static Row RowAt(Self& self, size_t index, std::index_sequence<Is...>) noexcept {
+        return Row(std::get<Is>(self.columns_).GetAddress()[index]...);
+    }
+
+    void SwapColumns(Columns& other) noexcept {
+        ForEachColumn([this, &other](auto i) {
+            std::get<decltype(i)::value>(columns_).Swap(std::get<decltype(i)::value>(other));
+        });
+    }
+
+    // Создаёт строку в позиции size_ столбцов columns
+    template <typename... Args>
+    void ConstructRow(Columns& columns, Args&&... args) {
+        auto refs = std::forward_as_tuple(std::forward<Args>(args)...);
+        ForEachColumnWithRollback(
+                [this, &columns, &refs](auto i) {
+                    constexpr size_t I = decltype(i)::value;
+                    new (std::get<I>(columns).GetAddress() + size_) FieldType<I>(std::get<I>(std::move(refs)));
+                },
+                [this, &columns](auto i) noexcept {
+                    std::destroy_at(std::get<decltype(i)::value>(columns).GetAddress() + size_);
+                });
+    }
+
+    // Создаёт count строк, инициализированных значением, начиная с позиции first
+    void ConstructRows(size_t first, size_t count) {
+        ForEachColumnWithRollback(
+                [this, first, count](auto i) {
+                    std::uninitialized_value_construct_n(std::get<decltype(i)::value>(columns_).GetAddress() + first,
+                                                         count);
+                },
+                [this, first, count](auto i) noexcept {
+                    std::destroy_n(std::get<decltype(i)::value>(columns_).GetAddress() + first, count);
+                });
+    }
+
+    static void DestroyRows(Columns& columns, size_t first, size_t count) noexcept {
+        ForEachColumn([&columns, first, count](auto i) {
+            std::destroy_n(std::get<decltype(i)::value>(columns).GetAddress() + first, count);
+        });
+    }
+
+    // Переносит строки в new_columns. Сначала копируются столбцы, перенос которых может выбросить
+    // исключение: при неудаче исходные строки остаются нетронутыми. Остальные столбцы переносятся после
+    void RelocateInto(Columns& new_columns) {
+        ForEachColumnWithRollback(
+                [this, &new_columns](auto i) {
+                    constexpr size_t I = decltype(i)::value;
+                    if constexpr (!IsNothrowRelocatable<FieldType<I>>) {
+                        detail::ElementOps<FieldType<I>>::MoveOrCopyN(std::get<I>(columns_).GetAddress(), size_,
+                                                                      std::get<I>(new_columns).GetAddress());
+                    }
+                },
+                [this, &new_columns](auto i) noexcept {
+                    constexpr size_t I = decltype(i)::value;
+                    if constexpr (!IsNothrowRelocatable<FieldType<I>>) {
+                        std::destroy_n(std::get<I>(new_columns).GetAddress(), size_);
+                    }
+                });
+        ForEachColumn([this, &new_columns](auto i) {
+            constexpr size_t I = decltype(i)::value;
+            if constexpr (IsNothrowRelocatable<FieldType<I>>) {
+                detail::ElementOps<FieldType<I>>::RelocateN(std::get<I>(columns_).GetAddress(), size_,
+                                                            std::get<I>(new_columns).GetAddress());
+            } else {
+                std::destroy_n(std::get<I>(columns_).GetAddress(), size_);
+            }
+        });
+    }
+
+    Columns columns_;
+    size_t size_ = 0;
+};
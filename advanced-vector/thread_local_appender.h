@@ -0,0 +1,109 @@
+#pragma once
+#include "vector.h"
+
+// Набор промежуточных буферов, по одному на рабочий поток: каждый поток добавляет элементы в свой
+// Local(worker) без синхронизации, а MergeInto переносит все буферы в конец одного вектора.
+// Вектор-приёмник расширяется один раз на суммарный размер, после чего буферы переносятся
+// параллельно, каждый по заранее вычисленному смещению. Буферы сохраняют ёмкость для следующего использования
+template <typename T, typename Allocator = std::allocator<T>>
+class ThreadLocalAppender {
+    using Buffer = Vector<T, Allocator>;
+
+public:
+    explicit ThreadLocalAppender(size_t workers, const Allocator& alloc = Allocator()) {
+        buffers_.Reserve(workers);
+        for (size_t i = 0; i < workers; ++i) {
+            buffers_.EmplaceBack(alloc);
+        }
+    }
+
+    size_t WorkerCount() const noexcept {
+        return buffers_.Size();
+    }
+
+    // Буфер рабочего потока worker. Разные потоки могут одновременно работать со своими буферами
+    Buffer& Local(size_t worker) noexcept {
+        return buffers_[worker];
+    }
+
+    const Buffer& Local(size_t worker) const noexcept {
+        return buffers_[worker];
+    }
+
+    // Суммарное количество элементов во всех буферах
+    size_t TotalSize() const noexcept {
+        size_t total = 0;
+        for (const Buffer& buffer : buffers_) {
+            total += buffer.Size();
+        }
+        return total;
+    }
+
+    // Переносит элементы всех буферов в конец dest в порядке номеров потоков и опустошает буферы.
+    // Вызывается, когда рабочие потоки не обращаются к своим буферам. Если перенос копированием
+    // выбрасывает исключение, буферы не изменяются, а у dest может увеличиться только ёмкость
+    template <typename GrowthPolicy, typename StatsPolicy, typename BoundsCheck>
+    void MergeInto(Vector<T, Allocator, GrowthPolicy, StatsPolicy, BoundsCheck>& dest, ParallelTag policy = PARALLEL) {
+        using Ops = detail::ElementOps<T, StatsPolicy>;
+
+        const size_t total = TotalSize();
+        if (total == 0) {
+            return;
+        }
+        if (total * sizeof(T) < PARALLEL_MIN_CHUNK_BYTES) {
+            policy = ParallelTag(1);
+        }
+        dest.Reserve(dest.Size() + total);
+
+        Vector<size_t> offsets(buffers_.Size());
+        for (size_t i = 0, offset = dest.Size(); i < buffers_.Size(); ++i) {
+            offsets[i] = offset;
+            offset += buffers_[i].Size();
+        }
+
+        auto target = dest.ReleaseBuffer();
+        T* const data = target.data;
+        try {
+            if constexpr (IsTriviallyRelocatableV<T> || std::is_nothrow_move_constructible_v<T>) {
+                detail::ParallelFor(policy, buffers_.Size(), 1, [this, data, &offsets](size_t begin, size_t end) {
+                    for (size_t i = begin; i != end; ++i) {
+                        Ops::RelocateN(buffers_[i].begin(), buffers_[i].Size(), data + offsets[i]);
+                    }
+                }, [](size_t, size_t) noexcept {});
+            } else {
+                detail::ParallelFor(policy, buffers_.Size(), 1, [this, data, &offsets](size_t begin, size_t end) {
+                    for (size_t i = begin; i != end; ++i) {
+                        Ops::MoveOrCopyN(buffers_[i].begin(), buffers_[i].Size(), data + offsets[i]);
+                    }
+                }, [this, data, &offsets](size_t begin, size_t end) noexcept {
+                    for (size_t i = begin; i != end; ++i) {
+                        std::destroy_n(data + offsets[i], buffers_[i].Size());
+                    }
+                });
+                for (Buffer& buffer : buffers_) {
+                    std::destroy_n(buffer.begin(), buffer.Size());
+                }
+            }
+        } catch (...) {
+            dest.AdoptBuffer(target);
+            throw;
+        }
+
+        // Элементы буферов уже перенесены: буферы опустошаются без вызова деструкторов
+        for (Buffer& buffer : buffers_) {
+            auto released = buffer.ReleaseBuffer();
+            buffer.AdoptBuffer({released.data, 0, released.capacity});
+        }
+        target.size += total;
+        dest.AdoptBuffer(target);
+    }
+
+    void Clear() noexcept {
+        for (Buffer& buffer : buffers_) {
+            buffer.Clear();
+        }
+    }
+
+private:
+    Vector<Buffer> buffers_;
+};
@@ -1,324 +1,1964 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <iterator>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <exception>
+#include <limits>
 #include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <memory>
 
+// В C++20 основные операции RawMemory и Vector с std::allocator доступны в константных выражениях:
+// Vector можно заполнить в constexpr-функции, например при построении таблицы на этапе компиляции.
+// Память, выделенная при константном вычислении, должна быть освобождена до его окончания
+#if __cplusplus >= 202002L && defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc)
+#define ADVANCED_VECTOR_HAS_CONSTEXPR 1
+#define ADVANCED_VECTOR_CONSTEXPR constexpr
+#else
+#define ADVANCED_VECTOR_HAS_CONSTEXPR 0
+#define ADVANCED_VECTOR_CONSTEXPR
+#endif
 
+// Признак тривиальной релоцируемости: объект типа T можно перенести в другую область памяти
+// побайтовым копированием, после чего исходный объект считается уничтоженным без вызова деструктора.
+// Для тривиально копируемых типов признак выводится автоматически, для остальных типов
+// (например, владеющих дескрипторов наподобие std::unique_ptr) включается явной специализацией:
+//     template <> struct IsTriviallyRelocatable<MyHandle> : std::true_type {};
 template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+
+// Размер строки кэша, на который ориентируются выравнивание буферов и политики роста
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Аллокатор, выравнивающий каждый выделенный буфер по границе Alignment байт
+// (но не слабее alignof(T)), что позволяет векторизованному коду использовать
+// выровненные загрузки прямо из хранилища Vector
+template <typename T, size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator {
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr size_t ALIGNMENT = std::max(Alignment, alignof(T));
+    static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "alignment must be a power of two");
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t{ALIGNMENT}));
+    }
+
+    void deallocate(T* p, size_t /*n*/) noexcept {
+        operator delete(p, std::align_val_t{ALIGNMENT});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept {
+        return false;
+    }
+};
+
+// Аллокатор, работающий через malloc/realloc/free. Помимо обычного интерфейса предоставляет
+// расширения, которыми пользуется RawMemory:
+//     try_expand(p, old_n, new_n) — увеличивает блок на месте, если это возможно без переноса;
+//     reallocate(p, old_n, new_n) — изменяет размер блока, возможно перенося его побайтово
+//                                   (glibc переотображает крупные блоки через mremap без копирования);
+//                                   при new_n == 0 освобождает блок и возвращает nullptr
+template <typename T>
+class MallocAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "malloc does not support over-aligned types");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    MallocAllocator() = default;
+
+    template <typename U>
+    MallocAllocator(const MallocAllocator<U>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        return CheckAllocated(std::malloc(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t /*n*/) noexcept {
+        std::free(p);
+    }
+
+    bool try_expand([[maybe_unused]] T* p, size_t /*old_n*/, [[maybe_unused]] size_t new_n) noexcept {
+#if defined(__GLIBC__)
+        return malloc_usable_size(p) >= new_n * sizeof(T);
+#else
+        return false;
+#endif
+    }
+
+    T* reallocate(T* p, size_t /*old_n*/, size_t new_n) {
+        if (new_n == 0) {
+            std::free(p);
+            return nullptr;
+        }
+        return CheckAllocated(std::realloc(p, new_n * sizeof(T)));
+    }
+
+    template <typename U>
+    bool operator==(const MallocAllocator<U>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const MallocAllocator<U>& /*other*/) const noexcept {
+        return false;
+    }
+
+private:
+    static T* CheckAllocated(void* p) {
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+    }
+};
+
+// Политика сбора статистики вызывается RawMemory и алгоритмами размещения элементов:
+//     OnAllocate(capacity, bytes), OnDeallocate(capacity, bytes) — выделение и освобождение буфера
+//         (успешные TryExpand и Reallocate учитываются как освобождение старого и выделение нового);
+//     OnMove(n), OnCopy(n) — перенос n элементов конструктором перемещения или копирования;
+//     OnRelocate(n) — побайтовый перенос n тривиально релоцируемых элементов.
+// NoStats не делает ничего и полностью устраняется компилятором
+struct NoStats {
+    static constexpr void OnAllocate(size_t /*capacity*/, size_t /*bytes*/) noexcept {
+    }
+
+    static constexpr void OnDeallocate(size_t /*capacity*/, size_t /*bytes*/) noexcept {
+    }
+
+    static constexpr void OnMove(size_t /*n*/) noexcept {
+    }
+
+    static constexpr void OnCopy(size_t /*n*/) noexcept {
+    }
+
+    static constexpr void OnRelocate(size_t /*n*/) noexcept {
+    }
+};
+
+// Снимок накопленной статистики
+struct VectorStats {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t allocated_bytes = 0;
+    size_t peak_capacity = 0;
+    size_t moved = 0;
+    size_t copied = 0;
+    size_t relocated = 0;
+};
+
+// Подсчитывает события во всех контейнерах, использующих эту политику. Разные теги Tag дают
+// независимые наборы счётчиков, например по одному на тип контейнера. Счётчики атомарны,
+// поэтому сбор статистики из нескольких потоков безопасен
+template <typename Tag = void>
+class CountingStats {
+public:
+    static void OnAllocate(size_t capacity, size_t bytes) noexcept {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+        size_t peak = peak_capacity_.load(std::memory_order_relaxed);
+        while (capacity > peak && !peak_capacity_.compare_exchange_weak(peak, capacity, std::memory_order_relaxed)) {
+        }
+    }
+
+    static void OnDeallocate(size_t /*capacity*/, size_t /*bytes*/) noexcept {
+        deallocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void OnMove(size_t n) noexcept {
+        moved_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    static void OnCopy(size_t n) noexcept {
+        copied_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    static void OnRelocate(size_t n) noexcept {
+        relocated_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    static VectorStats Get() noexcept {
+        VectorStats stats;
+        stats.allocations = allocations_.load(std::memory_order_relaxed);
+        stats.deallocations = deallocations_.load(std::memory_order_relaxed);
+        stats.allocated_bytes = allocated_bytes_.load(std::memory_order_relaxed);
+        stats.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+        stats.moved = moved_.load(std::memory_order_relaxed);
+        stats.copied = copied_.load(std::memory_order_relaxed);
+        stats.relocated = relocated_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    static void Reset() noexcept {
+        allocations_.store(0, std::memory_order_relaxed);
+        deallocations_.store(0, std::memory_order_relaxed);
+        allocated_bytes_.store(0, std::memory_order_relaxed);
+        peak_capacity_.store(0, std::memory_order_relaxed);
+        moved_.store(0, std::memory_order_relaxed);
+        copied_.store(0, std::memory_order_relaxed);
+        relocated_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static inline std::atomic<size_t> allocations_{0};
+    static inline std::atomic<size_t> deallocations_{0};
+    static inline std::atomic<size_t> allocated_bytes_{0};
+    static inline std::atomic<size_t> peak_capacity_{0};
+    static inline std::atomic<size_t> moved_{0};
+    static inline std::atomic<size_t> copied_{0};
+    static inline std::atomic<size_t> relocated_{0};
+};
+
+namespace detail {
+
+// Выполняется константное вычисление: побайтовые операции и алгоритмы std::uninitialized_*
+// в нём недоступны и заменяются поэлементными
+constexpr bool IsConstantEvaluated() noexcept {
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// Создаёт объект в неинициализированной памяти p, в том числе при константном вычислении
+template <typename T, typename... Args>
+ADVANCED_VECTOR_CONSTEXPR T* ConstructAt(T* p, Args&&... args) {
+#if ADVANCED_VECTOR_HAS_CONSTEXPR
+    return std::construct_at(p, std::forward<Args>(args)...);
+#else
+    return new (p) T(std::forward<Args>(args)...);
+#endif
+}
+
+// Создаёт n элементов, инициализированных значением
+template <typename T>
+ADVANCED_VECTOR_CONSTEXPR void ValueConstructN(T* p, size_t n) {
+    if (IsConstantEvaluated()) {
+        for (size_t i = 0; i != n; ++i) {
+            ConstructAt(p + i);
+        }
+    } else {
+        std::uninitialized_value_construct_n(p, n);
+    }
+}
+
+template <typename Allocator, typename = void>
+struct HasTryExpand : std::false_type {};
+
+template <typename Allocator>
+struct HasTryExpand<Allocator, std::void_t<decltype(std::declval<Allocator&>().try_expand(
+        std::declval<typename Allocator::value_type*>(), size_t{}, size_t{}))>> : std::true_type {};
+
+template <typename Allocator, typename = void>
+struct HasReallocate : std::false_type {};
+
+template <typename Allocator>
+struct HasReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+        std::declval<typename Allocator::value_type*>(), size_t{}, size_t{}))>> : std::true_type {};
+
+// Алгоритмы размещения элементов в сырой памяти, общие для Vector и SmallVector.
+// Работают с буфером data из size элементов и обеспечивают строгую гарантию безопасности исключений
+template <typename T, typename StatsPolicy = NoStats>
+struct ElementOps {
+    static constexpr bool CanMove() {
+        return std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+    }
+
+    // Сдвиг хвоста при удалении и групповой вставке можно выполнять через memmove, если элементы
+    // релоцируемы, а их перемещение не бросает исключений
+    static constexpr bool CanShiftBitwise() {
+        return IsTriviallyRelocatableV<T> && std::is_nothrow_move_constructible_v<T>;
+    }
+
+    template <typename InputIterator, typename ForwardIterator>
+    static ADVANCED_VECTOR_CONSTEXPR void MoveOrCopyN(InputIterator first, size_t n, ForwardIterator result)
+    {
+        if (IsConstantEvaluated()) {
+            // Исключение прерывает константное вычисление, поэтому откат не нужен
+            for (size_t i = 0; i != n; ++i, ++first, ++result) {
+                if constexpr (CanMove()) {
+                    ConstructAt(std::addressof(*result), std::move(*first));
+                } else {
+                    ConstructAt(std::addressof(*result), *first);
+                }
+            }
+        } else if constexpr (CanMove()) {
+            std::uninitialized_move_n(first, n, result);
+            StatsPolicy::OnMove(n);
+        } else {
+            std::uninitialized_copy_n(first, n, result);
+            StatsPolicy::OnCopy(n);
+        }
+    }
+
+    // Переносит n элементов из first в неинициализированную память result. После успешного
+    // завершения исходные элементы уничтожены. Если перенос прервался исключением,
+    // исходные элементы остаются нетронутыми
+    static ADVANCED_VECTOR_CONSTEXPR void RelocateN(T* first, size_t n, T* result) {
+        if (IsConstantEvaluated()) {
+            MoveOrCopyN(first, n, result);
+            std::destroy_n(first, n);
+        } else if constexpr (IsTriviallyRelocatableV<T>) {
+            if (n != 0) {
+                std::memcpy(static_cast<void*>(result), first, n * sizeof(T));
+            }
+            StatsPolicy::OnRelocate(n);
+        } else {
+            MoveOrCopyN(first, n, result);
+            std::destroy_n(first, n);
+        }
+    }
+
+    // Копирует n элементов, начиная с first, в неинициализированную память result.
+    // Для тривиально копируемых T и указателей на T выполняется единственный memcpy
+    template <typename ForwardIterator>
+    static ADVANCED_VECTOR_CONSTEXPR void CopyN(ForwardIterator first, size_t n, T* result) {
+        if (IsConstantEvaluated()) {
+            for (size_t i = 0; i != n; ++i, ++first) {
+                ConstructAt(result + i, *first);
+            }
+        } else if constexpr (std::is_trivially_copyable_v<T> && std::is_pointer_v<ForwardIterator>
+                      && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<ForwardIterator>>, T>) {
+            if (n != 0) {
+                std::memcpy(static_cast<void*>(result), first, n * sizeof(T));
+            }
+        } else {
+            std::uninitialized_copy_n(first, n, result);
+        }
+        StatsPolicy::OnCopy(n);
+    }
+
+    // Переносит элементы data в new_data, оставляя между позициями index и index + count промежуток,
+    // в котором уже созданы count новых элементов. При успехе элементы data уничтожены,
+    // при исключении data не изменяется, а созданные в промежутке элементы уничтожаются
+    static ADVANCED_VECTOR_CONSTEXPR void RelocateAround(T* data, size_t size, size_t index, size_t count, T* new_data) {
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            RelocateN(data, index, new_data);
+            RelocateN(data + index, size - index, new_data + index + count);
+        } else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            MoveOrCopyN(data, index, new_data);
+            MoveOrCopyN(data + index, size - index, new_data + index + count);
+            std::destroy_n(data, size);
+        } else {
+            try {
+                MoveOrCopyN(data, index, new_data);
+            } catch (...) {
+                std::destroy_n(new_data + index, count);
+                throw;
+            }
+            try {
+                MoveOrCopyN(data + index, size - index, new_data + index + count);
+            } catch (...) {
+                std::destroy_n(new_data, index + count);
+                throw;
+            }
+
+            std::destroy_n(data, size);
+        }
+    }
+
+    // Создаёт элемент в позиции index нового буфера new_data и переносит в него элементы data.
+    // При успехе элементы data уничтожены, при исключении data не изменяется, а new_data пуст
+    template<typename... Args>
+    static ADVANCED_VECTOR_CONSTEXPR void InsertIntoBuffer(T* data, size_t size, size_t index, T* new_data, Args&&... args)
+    {
+        ConstructAt(new_data + index, std::forward<Args>(args)...);
+        RelocateAround(data, size, index, 1, new_data);
+    }
+
+    // Вставку в позицию index можно выполнить без временного объекта: единственный аргумент
+    // является элементом того же типа, а сдвиг хвоста и присваивание не бросают исключений
+    template <typename... Args>
+    static constexpr bool CanAssignDirectly() {
+        if constexpr (sizeof...(Args) == 1) {
+            return (std::is_same_v<std::remove_cv_t<std::remove_reference_t<Args>>, T> && ...)
+                   && std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>
+                   && (std::is_nothrow_assignable_v<T&, Args> && ...);
+        } else {
+            return false;
+        }
+    }
+
+    // Вставляет элемент в позицию index буфера, в котором есть место хотя бы ещё для одного элемента
+    template<typename... Args>
+    static ADVANCED_VECTOR_CONSTEXPR void InsertWithoutReallocation(T* data, size_t size, size_t index, Args&&... args)
+    {
+        if(index == size)
+        {
+            ConstructAt(data + size, std::forward<Args>(args)...);
+        }
+        else if (IsConstantEvaluated())
+        {
+            // При вычислении на этапе компиляции побайтовый перенос недоступен: хвост сдвигается поэлементно
+            ShiftAndMoveAssign(data, size, index, std::forward<Args>(args)...);
+        }
+        else if constexpr (IsTriviallyRelocatableV<T>)
+        {
+            // Элемент создаётся в свободной ячейке за концом, пока аргументы, ссылающиеся на элементы,
+            // ещё валидны, и затем побайтово переносится на место без вызова конструктора перемещения
+            new (data + size) T(std::forward<Args>(args)...);
+            ShiftInBitwise(data, size, index, data + size);
+        }
+        else if constexpr (CanAssignDirectly<Args...>())
+        {
+            ShiftAndAssign(data, size, index, std::forward<Args>(args)...);
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>)
+        {
+            // Временный объект нужен, только если аргумент находится в буфере и сдвинется вместе с хвостом
+            if ((IsInBuffer(std::addressof(args), data, size) || ...)) {
+                ShiftAndMoveAssign(data, size, index, std::forward<Args>(args)...);
+            } else {
+                ShiftAndConstruct(data, size, index, std::forward<Args>(args)...);
+            }
+        }
+        else
+        {
+            ShiftAndMoveAssign(data, size, index, std::forward<Args>(args)...);
+        }
+    }
+
+    static bool IsInBuffer(const void* p, const T* data, size_t size) noexcept {
+        return !std::less<const void*>{}(p, data) && std::less<const void*>{}(p, data + size);
+    }
+
+    // Сдвигает хвост с позиции index на одну ячейку перемещениями, которые не выбрасывают исключений,
+    // и создаёт элемент из args прямо в освободившейся ячейке. Если конструктор выбрасывает исключение,
+    // хвост возвращается на место. Аргументы не должны находиться в сдвигаемых элементах
+    template<typename... Args>
+    static void ShiftAndConstruct(T* data, size_t size, size_t index, Args&&... args)
+    {
+        ConstructAt(data + size, std::move(data[size - 1]));
+        std::move_backward(data + index, data + (size - 1), data + size);
+        std::destroy_at(data + index);
+        try {
+            ConstructAt(data + index, std::forward<Args>(args)...);
+        } catch (...) {
+            ConstructAt(data + index, std::move(data[index + 1]));
+            std::move(data + index + 2, data + size + 1, data + index + 1);
+            std::destroy_at(data + size);
+            throw;
+        }
+    }
+
+    // Создаёт значение из args во временном объекте, сдвигает хвост с позиции index на одну ячейку
+    // перемещениями и перемещает временный объект в освободившуюся ячейку
+    template<typename... Args>
+    static ADVANCED_VECTOR_CONSTEXPR void ShiftAndMoveAssign(T* data, size_t size, size_t index, Args&&... args)
+    {
+        T tmp(std::forward<Args>(args)...);
+        ConstructAt(data + size, std::forward<T>(data[size - 1]));
+        try {
+            std::move_backward(data + index, data + (size - 1), data + size);
+        } catch (...) {
+            std::destroy_at(data + size);
+            throw;
+        }
+        data[index] = std::forward<T>(tmp);
+    }
+
+    // Сдвигает элементы с позиции index на одну ячейку к концу и побайтово переносит в освободившуюся
+    // ячейку объект value. Память value не должна пересекаться с элементами data
+    static void ShiftInBitwise(T* data, size_t size, size_t index, T* value) noexcept {
+        alignas(T) unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, static_cast<void*>(value), sizeof(T));
+        std::memmove(static_cast<void*>(data + index + 1), data + index, (size - index) * sizeof(T));
+        std::memcpy(static_cast<void*>(data + index), bytes, sizeof(T));
+    }
+
+    // Сдвигает хвост на одну ячейку и присваивает значение arg элементу в позиции index.
+    // Если arg ссылается на сдвигаемый элемент, значение берётся с его новой позиции
+    template <typename Arg>
+    static void ShiftAndAssign(T* data, size_t size, size_t index, Arg&& arg) noexcept {
+        auto* value = std::addressof(arg);
+        if (!std::less<const T*>{}(value, data + index) && std::less<const T*>{}(value, data + size)) {
+            ++value;
+        }
+        new (data + size) T(std::move(data[size - 1]));
+        std::move_backward(data + index, data + (size - 1), data + size);
+        data[index] = std::forward<Arg>(*value);
+    }
+
+    // Удаляет элемент в позиции index, сдвигая хвост к началу
+    static void Erase(T* data, size_t size, size_t index) {
+        if constexpr (CanShiftBitwise()) {
+            std::destroy_at(data + index);
+            std::memmove(static_cast<void*>(data + index), data + index + 1, (size - index - 1) * sizeof(T));
+        } else {
+            for(auto i = index; i != size - 1; ++i) {
+                data[i] = std::forward<T>(data[i + 1]);
+            }
+            std::destroy_at(data + size - 1);
+        }
+    }
+
+    // Удаляет count элементов начиная с позиции index, сдвигая хвост к началу за один проход
+    static void EraseN(T* data, size_t size, size_t index, size_t count) {
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            std::destroy_n(data + index, count);
+            std::memmove(static_cast<void*>(data + index), data + index + count,
+                         (size - index - count) * sizeof(T));
+        } else {
+            std::move(data + index + count, data + size, data + index);
+            std::destroy_n(data + size - count, count);
+        }
+    }
+
+    // Удаляет элементы, удовлетворяющие pred, сохраняя порядок остальных, и обновляет size.
+    // Тривиально релоцируемые элементы переносятся побайтово без присваиваний. Если pred
+    // выбрасывает исключение, непроверенные элементы сохраняются, а буфер остаётся сплошным
+    template <typename Predicate>
+    static void RemoveIf(T* data, size_t& size, Predicate& pred) {
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            size_t write = 0;
+            size_t read = 0;
+            try {
+                for (; read != size; ++read) {
+                    if (pred(data[read])) {
+                        std::destroy_at(data + read);
+                    } else {
+                        if (write != read) {
+                            std::memcpy(static_cast<void*>(data + write), data + read, sizeof(T));
+                        }
+                        ++write;
+                    }
+                }
+            } catch (...) {
+                std::memmove(static_cast<void*>(data + write), data + read, (size - read) * sizeof(T));
+                size = write + (size - read);
+                throw;
+            }
+            size = write;
+        } else {
+            T* new_end = std::remove_if(data, data + size, std::ref(pred));
+            const size_t new_size = new_end - data;
+            std::destroy_n(new_end, size - new_size);
+            size = new_size;
+        }
+    }
+};
+
+template <typename Iterator>
+using IteratorCategory = typename std::iterator_traits<Iterator>::iterator_category;
+
+template <typename Iterator, typename = void>
+inline constexpr bool IsInputIteratorV = false;
+
+template <typename Iterator>
+inline constexpr bool IsInputIteratorV<Iterator, std::void_t<IteratorCategory<Iterator>>> =
+        std::is_base_of_v<std::input_iterator_tag, IteratorCategory<Iterator>>;
+
+template <typename Iterator>
+inline constexpr bool IsForwardIteratorV =
+        std::is_base_of_v<std::forward_iterator_tag, IteratorCategory<Iterator>>;
+
+template <typename Iterator>
+using RequireInputIterator = std::enable_if_t<IsInputIteratorV<Iterator>, int>;
+
+}  // namespace detail
+
+#if defined(__GNUC__)
+#define ADVANCED_VECTOR_LIKELY(x) __builtin_expect(!!(x), 1)
+#define ADVANCED_VECTOR_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define ADVANCED_VECTOR_COLD __attribute__((cold, noinline))
+#else
+#define ADVANCED_VECTOR_LIKELY(x) (x)
+#define ADVANCED_VECTOR_UNLIKELY(x) (x)
+#define ADVANCED_VECTOR_COLD
+#endif
+
+namespace detail {
+
+// Сообщает о выходе индекса за границы и аварийно завершает программу. Вынесена из строки,
+// чтобы проверка в месте вызова сводилась к одному сравнению и редко выполняемому переходу
+[[noreturn]] ADVANCED_VECTOR_COLD inline void IndexOutOfRange(size_t index, size_t size) noexcept {
+    std::fprintf(stderr, "advanced-vector: index %zu is out of range [0, %zu)\n", index, size);
+    std::abort();
+}
+
+}  // namespace detail
+
+// Политики проверки индексов в operator[]:
+//     static void Check(size_t index, size_t size) noexcept;
+// UncheckedIndex проверяет индекс только assert'ом, CheckedIndex — при каждом обращении,
+// SampledIndex — при каждом Period-м обращении в потоке, обнаруживая ошибки с малыми накладными
+// расходами. Нарушение аварийно завершает программу, а исключение std::out_of_range выбрасывает At().
+// Проверка в CheckedIndex не изменяет состояния, поэтому в цикле по индексам, ограниченным размером,
+// компилятор может вынести её за пределы цикла или удалить
+struct UncheckedIndex {
+    static constexpr void Check([[maybe_unused]] size_t index, [[maybe_unused]] size_t size) noexcept {
+        assert(index < size);
+    }
+};
+
+struct CheckedIndex {
+    static constexpr void Check(size_t index, size_t size) noexcept {
+        if (ADVANCED_VECTOR_UNLIKELY(index >= size)) {
+            detail::IndexOutOfRange(index, size);
+        }
+    }
+};
+
+template <size_t Period = 64>
+struct SampledIndex {
+    static_assert(Period != 0 && (Period & (Period - 1)) == 0, "sampling period must be a power of two");
+
+    // При вычислении во время компиляции счётчик недоступен, и проверяется каждое обращение
+    static constexpr void Check(size_t index, size_t size) noexcept {
+        if (detail::IsConstantEvaluated() || ADVANCED_VECTOR_UNLIKELY(NextIsSampled())) {
+            CheckedIndex::Check(index, size);
+        } else {
+            UncheckedIndex::Check(index, size);
+        }
+    }
+
+private:
+    static bool NextIsSampled() noexcept {
+        // Счётчик другого типа, чем size_t: иначе по правилам алиасинга его запись могла бы изменить
+        // размеры и ёмкости контейнеров, и компилятор терял бы инварианты вроде встроенного буфера SmallVector
+        static thread_local unsigned counter = 0;
+        return (++counter & (Period - 1)) == 0;
+    }
+};
+
+// Политика по умолчанию выбирается при сборке макросом ADVANCED_VECTOR_CHECK_MODE, одинаковым
+// для всех единиц трансляции программы: 0 — UncheckedIndex, 1 — CheckedIndex, 2 — SampledIndex<>
+#define ADVANCED_VECTOR_UNCHECKED 0
+#define ADVANCED_VECTOR_CHECKED 1
+#define ADVANCED_VECTOR_SAMPLED 2
+
+#ifndef ADVANCED_VECTOR_CHECK_MODE
+#define ADVANCED_VECTOR_CHECK_MODE ADVANCED_VECTOR_UNCHECKED
+#endif
+
+#if ADVANCED_VECTOR_CHECK_MODE == ADVANCED_VECTOR_CHECKED
+using DefaultBoundsCheck = CheckedIndex;
+#elif ADVANCED_VECTOR_CHECK_MODE == ADVANCED_VECTOR_SAMPLED
+using DefaultBoundsCheck = SampledIndex<>;
+#else
+using DefaultBoundsCheck = UncheckedIndex;
+#endif
+
+template <typename T, typename Allocator = std::allocator<T>, typename StatsPolicy = NoStats>
 class RawMemory {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+                  "Allocator::value_type must be T");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>,
+                  "fancy pointers are not supported");
+
 public:
+    using allocator_type = Allocator;
+
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
-            : buffer_(Allocate(capacity))
-            , capacity_(capacity) {
+    ADVANCED_VECTOR_CONSTEXPR explicit RawMemory(const Allocator& alloc) noexcept
+            : alloc_(alloc) {
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR explicit RawMemory(size_t capacity, const Allocator& alloc = Allocator())
+            : alloc_(alloc)
+            , buffer_(Allocate(capacity))
+            , capacity_(capacity) {
+    }
+
+    RawMemory(const RawMemory&) = delete;
+    RawMemory& operator=(const RawMemory& rhs) = delete;
+    ADVANCED_VECTOR_CONSTEXPR RawMemory(RawMemory&& other) noexcept
+            : alloc_(std::move(other.alloc_))
+            , buffer_(std::exchange(other.buffer_, nullptr))
+            , capacity_(std::exchange(other.capacity_, 0)) {
+    }
+
+    // Память, полученная от аллокатора rhs, будет освобождена аллокатором *this,
+    // поэтому аллокаторы должны быть равны либо обмениваемы
+    ADVANCED_VECTOR_CONSTEXPR RawMemory& operator=(RawMemory&& rhs) noexcept {
+        Swap(rhs);
+        return *this;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR ~RawMemory() {
+        Deallocate(buffer_, capacity_);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR T* operator+(size_t offset) noexcept {
+        // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
+        DefaultBoundsCheck::Check(offset, capacity_ + 1);
+        return buffer_ + offset;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR const T* operator+(size_t offset) const noexcept {
+        return const_cast<RawMemory&>(*this) + offset;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
+        return const_cast<RawMemory&>(*this)[index];
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
+        DefaultBoundsCheck::Check(index, capacity_);
+        return buffer_[index];
+    }
+
+    // Аллокаторы обмениваются вместе с буферами, если это вообще возможно
+    // (например, std::pmr::polymorphic_allocator не допускает присваивания).
+    // Необмениваемые аллокаторы должны быть равны
+    ADVANCED_VECTOR_CONSTEXPR void Swap(RawMemory& other) noexcept {
+        if constexpr (std::is_swappable_v<Allocator>) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        } else {
+            assert(alloc_ == other.alloc_);
+        }
+        std::swap(buffer_, other.buffer_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR const T* GetAddress() const noexcept {
+        return buffer_;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR T* GetAddress() noexcept {
+        return buffer_;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR size_t Capacity() const {
+        return capacity_;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR const Allocator& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Принимает во владение буфер buffer ёмкостью capacity, выделенный аллокатором, равным GetAllocator(),
+    // и освобождает прежний буфер. Для политики статистики принятие буфера — выделение: он будет
+    // освобождён через Deallocate, и счётчики выделений и освобождений останутся согласованными
+    void AdoptBuffer(T* buffer, size_t capacity) noexcept {
+        Deallocate(buffer_, capacity_);
+        buffer_ = buffer;
+        capacity_ = capacity;
+        if (buffer_ != nullptr) {
+            StatsPolicy::OnAllocate(capacity_, capacity_ * sizeof(T));
+        }
+    }
+
+    // Отдаёт буфер вызывающему, который становится ответственным за его освобождение
+    // аллокатором GetAllocator(), и оставляет RawMemory пустым. Для политики статистики это освобождение
+    T* ReleaseBuffer() noexcept {
+        if (buffer_ != nullptr) {
+            StatsPolicy::OnDeallocate(capacity_, capacity_ * sizeof(T));
+        }
+        capacity_ = 0;
+        return std::exchange(buffer_, nullptr);
+    }
+
+    // Аллокатор умеет расширять блок на месте (try_expand)
+    static constexpr bool CanExpand() {
+        return detail::HasTryExpand<Allocator>::value;
+    }
+
+    // Аллокатор умеет изменять размер блока с побайтовым переносом содержимого (reallocate)
+    static constexpr bool CanReallocate() {
+        return detail::HasReallocate<Allocator>::value;
+    }
+
+    // Пытается увеличить ёмкость до new_capacity, не перемещая буфер.
+    // Размещённые в буфере объекты остаются на своих местах
+    ADVANCED_VECTOR_CONSTEXPR bool TryExpand(size_t new_capacity) noexcept {
+        if constexpr (CanExpand()) {
+            if (buffer_ != nullptr && alloc_.try_expand(buffer_, capacity_, new_capacity)) {
+                StatsPolicy::OnDeallocate(capacity_, capacity_ * sizeof(T));
+                StatsPolicy::OnAllocate(new_capacity, new_capacity * sizeof(T));
+                capacity_ = new_capacity;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Изменяет ёмкость буфера, при необходимости перенося его содержимое побайтово.
+    // Допустимо только для тривиально релоцируемых T. При исключении буфер не изменяется
+    void Reallocate(size_t new_capacity) {
+        static_assert(CanReallocate(), "allocator does not provide reallocate");
+        static_assert(IsTriviallyRelocatableV<T>, "reallocate moves objects bytewise");
+        buffer_ = alloc_.reallocate(buffer_, capacity_, new_capacity);
+        if (capacity_ != 0) {
+            StatsPolicy::OnDeallocate(capacity_, capacity_ * sizeof(T));
+        }
+        if (new_capacity != 0) {
+            StatsPolicy::OnAllocate(new_capacity, new_capacity * sizeof(T));
+        }
+        capacity_ = new_capacity;
+    }
+
+private:
+    // Выделяет сырую память под n элементов и возвращает указатель на неё
+    ADVANCED_VECTOR_CONSTEXPR T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        T* buf = AllocTraits::allocate(alloc_, n);
+        assert(detail::IsConstantEvaluated() || reinterpret_cast<std::uintptr_t>(buf) % alignof(T) == 0);
+        StatsPolicy::OnAllocate(n, n * sizeof(T));
+        return buf;
+    }
+
+    // Освобождает сырую память под n элементов, выделенную ранее по адресу buf при помощи Allocate
+    ADVANCED_VECTOR_CONSTEXPR void Deallocate(T* buf, size_t n) noexcept {
+        if (buf != nullptr) {
+            AllocTraits::deallocate(alloc_, buf, n);
+            StatsPolicy::OnDeallocate(n, n * sizeof(T));
+        }
+    }
+
+    [[no_unique_address]] Allocator alloc_;
+    T* buffer_ = nullptr;
+    size_t capacity_ = 0;
+};
+
+// Политика роста выбирает ёмкость нового буфера, когда вставка не помещается в текущий:
+//     static size_t NextCapacity(size_t capacity, size_t required, size_t element_size);
+// capacity — текущая ёмкость, required — минимально необходимая ёмкость,
+// element_size — размер элемента в байтах. Результат должен быть не меньше required
+
+// Геометрический рост с коэффициентом Numerator / Denominator
+template <size_t Numerator, size_t Denominator>
+struct FactorGrowth {
+    static_assert(Numerator > Denominator && Denominator > 0, "growth factor must be greater than 1");
+
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        constexpr size_t MAX_CAPACITY = std::numeric_limits<size_t>::max();
+        const size_t grown = capacity > MAX_CAPACITY / Numerator
+                             ? MAX_CAPACITY
+                             : capacity * Numerator / Denominator;
+        return std::max({grown, required, size_t{1}});
+    }
+};
+
+using DoublingGrowth = FactorGrowth<2, 1>;
+using OneAndHalfGrowth = FactorGrowth<3, 2>;
+
+// Удвоение, пока буфер меньше ThresholdBytes, а затем рост на ThresholdBytes за раз:
+// для очень больших векторов ограничивает неиспользуемый запас памяти
+template <size_t ThresholdBytes>
+struct DoublingThenLinearGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t threshold = std::max(ThresholdBytes / element_size, size_t{1});
+        const size_t grown = capacity < threshold
+                             ? DoublingGrowth::NextCapacity(capacity, required, element_size)
+                             : capacity + threshold;
+        return std::max(grown, required);
+    }
+};
+
+// Дополняет политику Policy минимальной ёмкостью в одну строку кэша,
+// чтобы первые вставки в пустой вектор не приводили к череде мелких реаллокаций
+template <typename Policy = DoublingGrowth>
+struct CacheLineMinGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t min_capacity = std::max(CACHE_LINE_SIZE / element_size, size_t{1});
+        return std::max(Policy::NextCapacity(capacity, required, element_size), min_capacity);
+    }
+};
+
+// Тег конструктора, создающего элементы инициализацией по умолчанию вместо инициализации значением.
+// Для тривиальных типов память не заполняется, что избавляет от лишнего прохода по буферу,
+// который всё равно будет перезаписан (например, при чтении данных из сети)
+struct DefaultInitTag {
+    explicit DefaultInitTag() = default;
+};
+
+inline constexpr DefaultInitTag DEFAULT_INIT{};
+
+// Тег параллельных версий конструкторов и операций, создающих, переносящих или уничтожающих
+// сразу все элементы. Работа делится на части между threads потоками (0 — по числу аппаратных потоков),
+// каждая часть не меньше PARALLEL_MIN_CHUNK_BYTES, поэтому небольшие векторы обрабатываются
+// в текущем потоке. Страницы памяти свежего буфера впервые затрагивает поток, создающий в них элементы,
+// поэтому в NUMA-системах они размещаются на узлах этих потоков
+struct ParallelTag {
+    explicit constexpr ParallelTag(size_t threads = 0) noexcept
+            : threads(threads) {
+    }
+
+    size_t threads;
+};
+
+inline constexpr ParallelTag PARALLEL{};
+
+inline constexpr size_t PARALLEL_MIN_CHUNK_BYTES = size_t{1} << 18;
+
+namespace detail {
+
+// Делит диапазон [0, n) на части не меньше min_chunk и вызывает func(begin, end) для каждой части
+// в отдельном потоке; первая часть выполняется в текущем. Если какая-либо часть выбросила исключение,
+// после завершения остальных для всех успешных частей вызывается rollback(begin, end),
+// а исключение первой неудачной части пробрасывается вызывающему
+template <typename Func, typename Rollback>
+void ParallelFor(ParallelTag policy, size_t n, size_t min_chunk, Func func, Rollback rollback) {
+    const size_t max_chunks = std::max<size_t>(n / std::max<size_t>(min_chunk, 1), 1);
+    const size_t threads = std::min(policy.threads != 0 ? policy.threads
+                                                        : std::max<size_t>(std::thread::hardware_concurrency(), 1),
+                                    max_chunks);
+    if (threads <= 1) {
+        func(size_t{0}, n);
+        return;
+    }
+
+    const auto bound = [n, threads](size_t chunk) {
+        return n / threads * chunk + std::min(chunk, n % threads);
+    };
+    std::unique_ptr<std::exception_ptr[]> errors(new std::exception_ptr[threads]);
+    std::unique_ptr<std::thread[]> workers(new std::thread[threads - 1]);
+    const auto run = [&](size_t chunk) noexcept {
+        try {
+            func(bound(chunk), bound(chunk + 1));
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    size_t started = 0;
+    try {
+        for (; started != threads - 1; ++started) {
+            workers[started] = std::thread(run, started + 1);
+        }
+    } catch (...) {
+        // Не удалось создать поток: оставшиеся части выполняются в текущем
+    }
+    for (size_t chunk = started + 1; chunk != threads; ++chunk) {
+        run(chunk);
+    }
+    run(0);
+    for (size_t i = 0; i != started; ++i) {
+        workers[i].join();
+    }
+
+    for (size_t failed = 0; failed != threads; ++failed) {
+        if (errors[failed]) {
+            for (size_t chunk = 0; chunk != threads; ++chunk) {
+                if (!errors[chunk]) {
+                    rollback(bound(chunk), bound(chunk + 1));
+                }
+            }
+            std::rethrow_exception(errors[failed]);
+        }
+    }
+}
+
+}  // namespace detail
+
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth,
+          typename StatsPolicy = NoStats, typename BoundsCheck = DefaultBoundsCheck>
+class Vector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using Ops = detail::ElementOps<T, StatsPolicy>;
+    using Memory = RawMemory<T, Allocator, StatsPolicy>;
+
+public:
+    using allocator_type = Allocator;
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+    // Итераторы — указатели: стандартные алгоритмы распознают непрерывный диапазон
+    // и выбирают для тривиальных типов memmove и memcmp
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    Vector() = default;
+
+    ADVANCED_VECTOR_CONSTEXPR explicit Vector(const Allocator& alloc) noexcept
+            : data_(alloc) {
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR explicit Vector(size_t size, const Allocator& alloc = Allocator())
+            : data_(size, alloc)
+            , size_(size)  //
+    {
+        detail::ValueConstructN(data_.GetAddress(), size_);
+    }
+
+    Vector(size_t size, DefaultInitTag, const Allocator& alloc = Allocator())
+            : data_(size, alloc)
+            , size_(size)  //
+    {
+        std::uninitialized_default_construct_n(data_.GetAddress(), size_);
+    }
+
+    Vector(size_t size, const T& value, const Allocator& alloc = Allocator())
+            : data_(size, alloc)
+    {
+        std::uninitialized_fill_n(data_.GetAddress(), size, value);
+        size_ = size;
+    }
+
+    // Тело выполняется после делегирующего конструктора, поэтому при исключении
+    // уже добавленные элементы уничтожает деструктор
+    template <typename InputIterator, detail::RequireInputIterator<InputIterator> = 0>
+    Vector(InputIterator first, InputIterator last, const Allocator& alloc = Allocator())
+            : Vector(alloc)
+    {
+        Assign(first, last);
+    }
+
+    // Параллельные версии конструкторов: элементы создаются несколькими потоками.
+    // Если создание элемента выбрасывает исключение, уже созданные элементы уничтожаются
+    Vector(ParallelTag policy, size_t size, const Allocator& alloc = Allocator())
+            : data_(size, alloc)
+    {
+        ParallelConstruct(policy, data_.GetAddress(), size, [this](size_t begin, size_t end) {
+            std::uninitialized_value_construct_n(data_.GetAddress() + begin, end - begin);
+        });
+        size_ = size;
+    }
+
+    Vector(ParallelTag policy, const Vector& other)
+            : data_(other.size_, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
+    {
+        ParallelConstruct(policy, data_.GetAddress(), other.size_, [this, &other](size_t begin, size_t end) {
+            Ops::CopyN(other.data_.GetAddress() + begin, end - begin, data_.GetAddress() + begin);
+        });
+        size_ = other.size_;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR Vector(const Vector& other)
+            : Vector(other, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
+    {
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR Vector(const Vector& other, const Allocator& alloc)
+            : data_(other.size_, alloc)
+            , size_(other.size_)
+    {
+        Ops::CopyN(other.data_.GetAddress(), other.size_, data_.GetAddress());
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR Vector(Vector&& other) noexcept
+            : data_(std::move(other.data_))
+            , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    // Если аллокаторы не равны, элементы перемещаются по одному в память, выделенную alloc
+    Vector(Vector&& other, const Allocator& alloc)
+            : data_(alloc)
+    {
+        if (AllocTraits::is_always_equal::value || other.data_.GetAllocator() == alloc) {
+            data_.Swap(other.data_);
+            std::swap(size_, other.size_);
+        } else {
+            Memory new_data(other.size_, alloc);
+            Ops::MoveOrCopyN(other.data_.GetAddress(), other.size_, new_data.GetAddress());
+            data_.Swap(new_data);
+            size_ = other.size_;
+        }
+    }
+
+    Vector& operator=(const Vector& rhs) {
+        if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value
+                          && !AllocTraits::is_always_equal::value) {
+                if (data_.GetAllocator() != rhs.data_.GetAllocator()) {
+                    Vector rhs_copy(rhs, rhs.data_.GetAllocator());
+                    SwapData(rhs_copy);
+                    return *this;
+                }
+            }
+            // Способ копирования выбирается на этапе компиляции:
+            // - не помещающиеся элементы копируются в новый буфер, который заменяет старый только
+            //   после успешного копирования, либо в перевыделенный буфер (см. GrowForOverwrite);
+            // - тривиально копируемые элементы копируются одним memcpy без уничтожения старых;
+            // - остальные присваиваются на месте, недостающие создаются, лишние уничтожаются
+            if (rhs.size_ > data_.Capacity()) {
+                GrowForOverwrite(rhs.size_, rhs.data_.GetAddress());
+            } else if constexpr (std::is_trivially_copyable_v<T>) {
+                if (rhs.size_ != 0) {
+                    std::memcpy(static_cast<void*>(data_.GetAddress()), rhs.data_.GetAddress(), rhs.size_ * sizeof(T));
+                }
+            } else {
+                std::copy(rhs.data_.GetAddress(), rhs.data_.GetAddress() + std::min(rhs.size_, size_), data_.GetAddress());
+                if(rhs.size_ <= size_) {
+                    std::destroy_n(data_.GetAddress() + rhs.size_, size_ - rhs.size_);
+                } else {
+                    std::uninitialized_copy_n(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
+                }
+            }
+            size_ = rhs.size_;
+        }
+        return *this;
+    }
+
+    // Буфер rhs забирается целиком, если аллокатор распространяется при перемещении
+    // либо аллокаторы равны. Иначе элементы перемещаются в память текущего аллокатора
+    ADVANCED_VECTOR_CONSTEXPR Vector& operator=(Vector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                             || AllocTraits::is_always_equal::value) {
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value
+                      || AllocTraits::is_always_equal::value) {
+            SwapData(rhs);
+        } else {
+            Vector rhs_moved(std::move(rhs), data_.GetAllocator());
+            SwapData(rhs_moved);
+        }
+        return *this;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void Swap(Vector& other) noexcept {
+        // Без propagate_on_container_swap обмен допустим только для равных аллокаторов
+        assert(AllocTraits::propagate_on_container_swap::value || AllocTraits::is_always_equal::value
+               || data_.GetAllocator() == other.data_.GetAllocator());
+        SwapData(other);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR allocator_type GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR size_t Size() const noexcept {
+        return size_;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR size_t MaxSize() const noexcept {
+        return std::min<size_t>(AllocTraits::max_size(data_.GetAllocator()),
+                                std::numeric_limits<std::ptrdiff_t>::max() / sizeof(T));
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        ResizeWith(new_size, [](T* first, T* last) {
+            detail::ValueConstructN(first, static_cast<size_t>(last - first));
+        });
+    }
+
+    void Resize(ParallelTag policy, size_t new_size) {
+        if (new_size <= size_) {
+            ParallelDestroy(policy, data_.GetAddress() + new_size, size_ - new_size);
+        } else {
+            Reserve(policy, new_size);
+            T* const tail = data_.GetAddress() + size_;
+            ParallelConstruct(policy, tail, new_size - size_, [tail](size_t begin, size_t end) {
+                std::uninitialized_value_construct_n(tail + begin, end - begin);
+            });
+        }
+        size_ = new_size;
+    }
+
+    // Новые элементы копируются из value, который может ссылаться на элемент самого вектора
+    void Resize(size_t new_size, const T& value) {
+        if (new_size <= size_) {
+            std::destroy(data_.GetAddress() + new_size, data_.GetAddress() + size_);
+            size_ = new_size;
+        } else {
+            Insert(end(), new_size - size_, value);
+        }
+    }
+
+    // Как Resize, но новые элементы инициализируются по умолчанию:
+    // для тривиальных типов их значения остаются неопределёнными
+    void ResizeDefaultInit(size_t new_size) {
+        ResizeWith(new_size, [](T* first, T* last) {
+            std::uninitialized_default_construct(first, last);
+        });
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void PushBack(T&& value) noexcept {
+        EmplaceBack(std::move(value));
+    }
+
+    // Пока есть свободное место, добавление сводится к сравнению с ёмкостью и созданию элемента,
+    // а рост вынесен в отдельную холодную функцию, чтобы не мешать встраиванию
+    template <typename... Args>
+    ADVANCED_VECTOR_CONSTEXPR T& EmplaceBack(Args&&... args) {
+        if (ADVANCED_VECTOR_LIKELY(size_ < data_.Capacity())) {
+            return UncheckedEmplaceBack(std::forward<Args>(args)...);
+        }
+        return GrowAndEmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Добавляет элемент без проверки ёмкости: вызывающий заранее обеспечил место вызовом Reserve
+    template <typename... Args>
+    ADVANCED_VECTOR_CONSTEXPR T& UncheckedEmplaceBack(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        assert(size_ < data_.Capacity());
+        T* const value = detail::ConstructAt(data_.GetAddress() + size_, std::forward<Args>(args)...);
+        ++size_;
+        return *value;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void PopBack() {
+        std::destroy_at(data_.GetAddress() + size_ - 1);
+        --size_;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
+        if (new_capacity <= data_.Capacity()) {
+            return;
+        }
+        if (data_.TryExpand(new_capacity)) {
+            return;
+        }
+        if constexpr (IsTriviallyRelocatableV<T> && Memory::CanReallocate()) {
+            data_.Reallocate(new_capacity);
+        } else {
+            Memory new_data(new_capacity, data_.GetAllocator());
+
+            Ops::RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
+
+            data_.Swap(new_data);
+        }
+    }
+
+    // Параллельная версия Reserve. Гарантии при исключениях те же, что у последовательной версии
+    void Reserve(ParallelTag policy, size_t new_capacity) {
+        if (new_capacity <= data_.Capacity()) {
+            return;
+        }
+        if (data_.TryExpand(new_capacity)) {
+            return;
+        }
+        if constexpr (IsTriviallyRelocatableV<T> && Memory::CanReallocate()) {
+            data_.Reallocate(new_capacity);
+        } else {
+            Memory new_data(new_capacity, data_.GetAllocator());
+            T* const src = data_.GetAddress();
+            T* const dst = new_data.GetAddress();
+            if constexpr (IsTriviallyRelocatableV<T> || std::is_nothrow_move_constructible_v<T>) {
+                detail::ParallelFor(policy, size_, ChunkSize(), [src, dst](size_t begin, size_t end) {
+                    Ops::RelocateN(src + begin, end - begin, dst + begin);
+                }, [](size_t, size_t) noexcept {});
+            } else {
+                ParallelConstruct(policy, dst, size_, [src, dst](size_t begin, size_t end) {
+                    Ops::MoveOrCopyN(src + begin, end - begin, dst + begin);
+                });
+                ParallelDestroy(policy, src, size_);
+            }
+            data_.Swap(new_data);
+        }
+    }
+
+    // Уничтожает все элементы, сохраняя ёмкость
+    ADVANCED_VECTOR_CONSTEXPR void Clear() noexcept {
+        std::destroy_n(data_.GetAddress(), size_);
+        size_ = 0;
+    }
+
+    // Параллельная версия Clear. Вызов перед разрушением очень большого вектора
+    // распределяет работу деструкторов между потоками
+    void Clear(ParallelTag policy) noexcept {
+        ParallelDestroy(policy, data_.GetAddress(), size_);
+        size_ = 0;
+    }
+
+    // Уменьшает ёмкость до размера, возвращая излишек памяти аллокатору.
+    // Пустой вектор освобождает буфер полностью. При исключении вектор не изменяется
+    void ShrinkToFit() {
+        if (size_ == data_.Capacity()) {
+            return;
+        }
+        if constexpr (IsTriviallyRelocatableV<T> && Memory::CanReallocate()) {
+            // Пустой вектор освобождает буфер вызовом reallocate(p, n, 0), который аллокатор может отличить
+            // от разрушения вектора: FileMappedAllocator при этом обрезает файл, а не сохраняет его содержимое
+            data_.Reallocate(size_);
+        } else if (size_ == 0) {
+            Memory empty(data_.GetAllocator());
+            data_.Swap(empty);
+        } else {
+            Memory new_data(size_, data_.GetAllocator());
+            Ops::RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
+            data_.Swap(new_data);
+        }
+    }
+
+    // Объём памяти в байтах, выделенной вектором под элементы
+    size_t MemoryUsage() const noexcept {
+        return data_.Capacity() * sizeof(T);
+    }
+
+    // Буфер вместе с созданными в его начале size элементами, передаваемый между вектором и внешним кодом
+    struct Buffer {
+        T* data = nullptr;
+        size_t size = 0;
+        size_t capacity = 0;
+    };
+
+    // Принимает во владение буфер, выделенный аллокатором, равным GetAllocator(), не перенося элементы.
+    // Прежние элементы уничтожаются, а их буфер освобождается
+    void AdoptBuffer(Buffer buffer) noexcept {
+        assert(buffer.size <= buffer.capacity);
+        std::destroy_n(data_.GetAddress(), size_);
+        data_.AdoptBuffer(buffer.data, buffer.capacity);
+        size_ = buffer.size;
+    }
+
+    // Отдаёт буфер с элементами вызывающему и оставляет вектор пустым. Вызывающий отвечает
+    // за уничтожение элементов и освобождение буфера аллокатором GetAllocator() либо передаёт буфер в AdoptBuffer
+    Buffer ReleaseBuffer() noexcept {
+        Buffer buffer{data_.GetAddress(), std::exchange(size_, 0), data_.Capacity()};
+        data_.ReleaseBuffer();
+        return buffer;
+    }
+
+    // Элементы тривиально копируемого типа как непрерывная последовательность из ByteSize() байт
+    const std::byte* Bytes() const noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "byte view requires trivially copyable elements");
+        return reinterpret_cast<const std::byte*>(data_.GetAddress());
+    }
+
+    std::byte* Bytes() noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "byte view requires trivially copyable elements");
+        return reinterpret_cast<std::byte*>(data_.GetAddress());
+    }
+
+    size_t ByteSize() const noexcept {
+        return size_ * sizeof(T);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR T* Data() noexcept {
+        return data_.GetAddress();
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR const T* Data() const noexcept {
+        return data_.GetAddress();
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR iterator begin() noexcept {
+        return data_.GetAddress();
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR iterator end() noexcept {
+        return data_.GetAddress() + size_;
     }
 
-    RawMemory(const RawMemory&) = delete;
-    RawMemory& operator=(const RawMemory& rhs) = delete;
-    RawMemory(RawMemory&& other) noexcept
-    {
-        Swap(other);
+    ADVANCED_VECTOR_CONSTEXPR const_iterator begin() const noexcept {
+        return data_.GetAddress();
+    }
+    ADVANCED_VECTOR_CONSTEXPR const_iterator end() const noexcept {
+        return data_.GetAddress() + size_;
     }
 
-    RawMemory& operator=(RawMemory&& rhs) noexcept {
-        Swap(rhs);
-        return *this;
+    ADVANCED_VECTOR_CONSTEXPR const_iterator cbegin() const noexcept {
+        return begin();
     }
 
-    ~RawMemory() {
-        Deallocate(buffer_);
+    ADVANCED_VECTOR_CONSTEXPR const_iterator cend() const noexcept {
+        return end();
     }
 
-    T* operator+(size_t offset) noexcept {
-        // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
-        assert(offset <= capacity_);
-        return buffer_ + offset;
+    ADVANCED_VECTOR_CONSTEXPR reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
     }
 
-    const T* operator+(size_t offset) const noexcept {
-        return const_cast<RawMemory&>(*this) + offset;
+    ADVANCED_VECTOR_CONSTEXPR reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
     }
 
-    const T& operator[](size_t index) const noexcept {
-        return const_cast<RawMemory&>(*this)[index];
+    ADVANCED_VECTOR_CONSTEXPR const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
     }
 
-    T& operator[](size_t index) noexcept {
-        assert(index < capacity_);
-        return buffer_[index];
+    ADVANCED_VECTOR_CONSTEXPR const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
     }
 
-    void Swap(RawMemory& other) noexcept {
-        std::swap(buffer_, other.buffer_);
-        std::swap(capacity_, other.capacity_);
+    ADVANCED_VECTOR_CONSTEXPR const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
     }
 
-    const T* GetAddress() const noexcept {
-        return buffer_;
+    ADVANCED_VECTOR_CONSTEXPR const_reverse_iterator crend() const noexcept {
+        return rend();
     }
 
-    T* GetAddress() noexcept {
-        return buffer_;
+    template <typename... Args>
+    ADVANCED_VECTOR_CONSTEXPR iterator Emplace(const_iterator pos, Args&&... args) {
+        auto index = pos - begin();
+        if(size_ < data_.Capacity()) {
+            InsertWithoutReallocation(index, std::forward<Args>(args)...);
+        } else {
+            InsertWithReallocation(index, std::forward<Args>(args)...);
+        }
+        ++size_;
+        return data_.GetAddress() + index;
     }
 
-    size_t Capacity() const {
-        return capacity_;
+    iterator Erase(const_iterator pos) /*noexcept(std::is_nothrow_move_assignable_v<T>)*/ {
+        if(pos == (end() - 1)) {
+            PopBack();
+            return end();
+        }
+        size_t index = pos - begin();
+        Ops::Erase(data_.GetAddress(), size_, index);
+        --size_;
+        return data_.GetAddress() + index;
     }
 
-private:
-    // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    // Удаляет элемент за O(1), перенося на его место последний элемент.
+    // Порядок элементов не сохраняется. Возвращает итератор на элемент, занявший позицию pos
+    iterator EraseUnordered(const_iterator pos) {
+        assert(pos >= begin() && pos < end());
+        const size_t index = pos - begin();
+        T* const last = data_.GetAddress() + size_ - 1;
+        if (data_.GetAddress() + index != last) {
+            if constexpr (IsTriviallyRelocatableV<T>) {
+                std::destroy_at(data_.GetAddress() + index);
+                std::memcpy(static_cast<void*>(data_.GetAddress() + index), last, sizeof(T));
+                --size_;
+                return begin() + index;
+            } else {
+                data_.GetAddress()[index] = std::move(*last);
+            }
+        }
+        PopBack();
+        return begin() + index;
     }
 
-    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    // Удаляет элементы [first, last), сдвигая хвост один раз
+    iterator Erase(const_iterator first, const_iterator last) {
+        assert(first >= begin() && first <= last && last <= end());
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        if (count != 0) {
+            Ops::EraseN(data_.GetAddress(), size_, index, count);
+            size_ -= count;
+        }
+        return begin() + index;
     }
 
-    T* buffer_ = nullptr;
-    size_t capacity_ = 0;
-};
+    // Удаляет из вектора все элементы, удовлетворяющие предикату, за один проход
+    // и возвращает количество удалённых элементов
+    template <typename Predicate>
+    friend size_t EraseIf(Vector& v, Predicate pred) {
+        const size_t old_size = v.size_;
+        Ops::RemoveIf(v.data_.GetAddress(), v.size_, pred);
+        return old_size - v.size_;
+    }
 
-template <typename T>
-class Vector {
-public:
-    Vector() = default;
+    ADVANCED_VECTOR_CONSTEXPR iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
 
-    explicit Vector(size_t size)
-            : data_(size)
-            , size_(size)  //
-    {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size_);
+    ADVANCED_VECTOR_CONSTEXPR iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
     }
 
-    Vector(const Vector& other)
-            : data_(other.size_)
-            , size_(other.size_)
-    {
-        std::uninitialized_copy_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+    // Вставляет count копий value перед pos. value может ссылаться на элемент самого вектора
+    iterator Insert(const_iterator pos, size_t count, const T& value) {
+        const size_t index = pos - begin();
+        if (count == 0) {
+            return begin() + index;
+        }
+        const T value_copy(value);
+        return InsertN(index, count,
+                       [&value_copy](T* dst, size_t /*offset*/, size_t n) {
+                           std::uninitialized_fill_n(dst, n, value_copy);
+                       },
+                       [&value_copy](T* dst, size_t /*offset*/, size_t n) {
+                           std::fill_n(dst, n, value_copy);
+                       });
     }
 
-    Vector(Vector&& other) noexcept
-    {
-        Swap(other);
-    };
+    // Вставляет элементы диапазона [first, last) перед pos. Ёмкость вычисляется один раз,
+    // хвост вектора сдвигается один раз. Диапазон не должен ссылаться на элементы самого вектора.
+    // При реаллокации обеспечивается строгая гарантия безопасности исключений, иначе — базовая
+    template <typename InputIterator, detail::RequireInputIterator<InputIterator> = 0>
+    iterator Insert(const_iterator pos, InputIterator first, InputIterator last) {
+        const size_t index = pos - begin();
+        if constexpr (detail::IsForwardIteratorV<InputIterator>) {
+            const size_t count = std::distance(first, last);
+            if (count == 0) {
+                return begin() + index;
+            }
+            return InsertN(index, count,
+                           [first](T* dst, size_t offset, size_t n) {
+                               Ops::CopyN(std::next(first, offset), n, dst);
+                           },
+                           [first](T* dst, size_t offset, size_t n) {
+                               std::copy_n(std::next(first, offset), n, dst);
+                           });
+        } else if (index == size_) {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+            return begin() + index;
+        } else {
+            // Длина однопроходного диапазона заранее неизвестна: элементы собираются во временный вектор
+            Vector tmp(data_.GetAllocator());
+            tmp.Append(first, last);
+            return Insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+        }
+    }
 
-    Vector& operator=(const Vector& rhs) {
-        if (this != &rhs) {
-            if (rhs.size_ > data_.Capacity()) {
-                Vector rhs_copy(rhs);
-                Swap(rhs_copy);
+    template <typename InputIterator, detail::RequireInputIterator<InputIterator> = 0>
+    void Append(InputIterator first, InputIterator last) {
+        Insert(end(), first, last);
+    }
+
+    // Заменяет содержимое вектора элементами диапазона [first, last)
+    template <typename InputIterator, detail::RequireInputIterator<InputIterator> = 0>
+    void Assign(InputIterator first, InputIterator last) {
+        if constexpr (detail::IsForwardIteratorV<InputIterator>) {
+            const size_t count = std::distance(first, last);
+            if (count > data_.Capacity()) {
+                GrowForOverwrite(count, first);
+            } else if (count <= size_) {
+                std::copy_n(first, count, data_.GetAddress());
+                std::destroy_n(data_.GetAddress() + count, size_ - count);
             } else {
-                std::copy(rhs.data_.GetAddress(), rhs.data_.GetAddress() + std::min(rhs.size_, size_), data_.GetAddress());
-                if(rhs.size_ <= size_) {
-                    std::destroy_n(data_.GetAddress() + rhs.size_, size_ - rhs.size_);
-                } else {
-                    std::uninitialized_copy_n(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
-                }
-                size_ = rhs.size_;
+                const auto mid = std::next(first, size_);
+                std::copy(first, mid, data_.GetAddress());
+                Ops::CopyN(mid, count - size_, data_.GetAddress() + size_);
+            }
+            size_ = count;
+        } else {
+            size_t assigned = 0;
+            for (; first != last && assigned != size_; ++first, ++assigned) {
+                data_.GetAddress()[assigned] = *first;
+            }
+            std::destroy_n(data_.GetAddress() + assigned, size_ - assigned);
+            size_ = assigned;
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
             }
         }
-        return *this;
     }
 
-    Vector& operator=(Vector&& rhs) noexcept {
-        Swap(rhs);
-        return *this;
+    ADVANCED_VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
+        return const_cast<Vector&>(*this)[index];
     }
 
-    void Swap(Vector& other) noexcept {
-        std::swap(data_, other.data_);
-        std::swap(size_, other.size_);
+    ADVANCED_VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
+        BoundsCheck::Check(index, size_);
+        return data_.GetAddress()[index];
     }
 
-    size_t Size() const noexcept {
-        return size_;
+    // Доступ с проверкой индекса независимо от политики: выбрасывает std::out_of_range
+    ADVANCED_VECTOR_CONSTEXPR const T& At(size_t index) const {
+        return const_cast<Vector&>(*this).At(index);
     }
 
-    size_t Capacity() const noexcept {
-        return data_.Capacity();
+    ADVANCED_VECTOR_CONSTEXPR T& At(size_t index) {
+        if (ADVANCED_VECTOR_UNLIKELY(index >= size_)) {
+            throw std::out_of_range("Vector::At: index out of range");
+        }
+        return data_.GetAddress()[index];
     }
 
-    void Resize(size_t new_size) {
-        if(size_ == new_size) {
-            return;
-        }
-        if(new_size < size_) {
-            std::destroy(data_.GetAddress() + new_size, data_.GetAddress() + size_);
-        } else {
-            Reserve(new_size);
-            std::uninitialized_value_construct(data_.GetAddress() + size_, data_.GetAddress() + new_size);
-        }
-        size_ = new_size;
+    ADVANCED_VECTOR_CONSTEXPR T& Front() noexcept {
+        return (*this)[0];
     }
 
-    void PushBack(const T& value) {
-        EmplaceBack(value);
+    ADVANCED_VECTOR_CONSTEXPR const T& Front() const noexcept {
+        return (*this)[0];
     }
 
-    void PushBack(T&& value) noexcept {
-        EmplaceBack(std::move(value));
+    ADVANCED_VECTOR_CONSTEXPR T& Back() noexcept {
+        return (*this)[size_ - 1];
     }
 
-    template <typename... Args>
-    T& EmplaceBack(Args&&... args) {
-        return *Emplace(end(), std::forward<Args>(args)...);
+    ADVANCED_VECTOR_CONSTEXPR const T& Back() const noexcept {
+        return (*this)[size_ - 1];
     }
 
-    void PopBack() {
-        std::destroy_at(data_ + size_ - 1);
-        --size_;
+    // Интерфейс std::vector для обобщённого кода, стандартных алгоритмов и std::ranges.
+    // Каждая функция вызывает соответствующую операцию Vector с теми же гарантиями
+    ADVANCED_VECTOR_CONSTEXPR size_type size() const noexcept {
+        return Size();
     }
 
-    void Reserve(size_t new_capacity) {
-        if (new_capacity <= data_.Capacity()) {
-            return;
-        }
-        RawMemory<T> new_data(new_capacity);
+    ADVANCED_VECTOR_CONSTEXPR size_type capacity() const noexcept {
+        return Capacity();
+    }
 
-        MoveOrCopyN(data_.GetAddress(), size_, new_data.GetAddress());
+    ADVANCED_VECTOR_CONSTEXPR size_type max_size() const noexcept {
+        return MaxSize();
+    }
 
-        std::destroy_n(data_.GetAddress(), size_);
+    ADVANCED_VECTOR_CONSTEXPR bool empty() const noexcept {
+        return Empty();
+    }
 
-        data_.Swap(new_data);
+    ADVANCED_VECTOR_CONSTEXPR pointer data() noexcept {
+        return Data();
     }
 
-    using iterator = T*;
-    using const_iterator = const T*;
+    ADVANCED_VECTOR_CONSTEXPR const_pointer data() const noexcept {
+        return Data();
+    }
 
-    iterator begin() noexcept {
-        return data_.GetAddress();
+    ADVANCED_VECTOR_CONSTEXPR reference front() noexcept {
+        return Front();
     }
 
-    iterator end() noexcept {
-        return data_ + size_;
+    ADVANCED_VECTOR_CONSTEXPR const_reference front() const noexcept {
+        return Front();
     }
 
-    const_iterator begin() const noexcept {
-        return data_.GetAddress();
+    ADVANCED_VECTOR_CONSTEXPR reference back() noexcept {
+        return Back();
     }
-    const_iterator end() const noexcept {
-        return data_ + size_;
+
+    ADVANCED_VECTOR_CONSTEXPR const_reference back() const noexcept {
+        return Back();
     }
 
-    const_iterator cbegin() const noexcept {
-        return begin();
+    ADVANCED_VECTOR_CONSTEXPR reference at(size_type index) {
+        return At(index);
     }
 
-    const_iterator cend() const noexcept {
-        return end();
+    ADVANCED_VECTOR_CONSTEXPR const_reference at(size_type index) const {
+        return At(index);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR allocator_type get_allocator() const noexcept {
+        return GetAllocator();
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void reserve(size_type new_capacity) {
+        Reserve(new_capacity);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void resize(size_type new_size) {
+        Resize(new_size);
+    }
+
+    void resize(size_type new_size, const T& value) {
+        Resize(new_size, value);
+    }
+
+    void shrink_to_fit() {
+        ShrinkToFit();
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void clear() noexcept {
+        Clear();
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void push_back(const T& value) {
+        PushBack(value);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void push_back(T&& value) {
+        PushBack(std::move(value));
     }
 
     template <typename... Args>
-    iterator Emplace(const_iterator pos, Args&&... args) {
-        auto index = pos - begin();
-        if(size_ < data_.Capacity()) {
-            InsertWithoutReallocation(index, std::forward<Args>(args)...);
-        } else {
-            InsertWithReallocation(index, std::forward<Args>(args)...);
-        }
-        ++size_;
-        return data_.GetAddress() + index;
+    ADVANCED_VECTOR_CONSTEXPR reference emplace_back(Args&&... args) {
+        return EmplaceBack(std::forward<Args>(args)...);
     }
 
-    iterator Erase(const_iterator pos) /*noexcept(std::is_nothrow_move_assignable_v<T>)*/ {
-        if(pos == (end() - 1)) {
-            PopBack();
-            return end();
-        }
-        size_t index = pos - begin();
-        for(auto i = index; i != size_ - 1; ++i) {
-            data_[i] = std::forward<T>(data_[i + 1]);
-        }
-        std::destroy_at(data_ + size_ - 1);
-        --size_;
-        return data_ + index;
+    ADVANCED_VECTOR_CONSTEXPR void pop_back() {
+        PopBack();
     }
 
-    iterator Insert(const_iterator pos, const T& value) {
-        return Emplace(pos, value);
+    template <typename... Args>
+    ADVANCED_VECTOR_CONSTEXPR iterator emplace(const_iterator pos, Args&&... args) {
+        return Emplace(pos, std::forward<Args>(args)...);
     }
 
-    iterator Insert(const_iterator pos, T&& value) {
-        return Emplace(pos, std::move(value));
+    ADVANCED_VECTOR_CONSTEXPR iterator insert(const_iterator pos, const T& value) {
+        return Insert(pos, value);
     }
 
-    const T& operator[](size_t index) const noexcept {
-        return const_cast<Vector&>(*this)[index];
+    ADVANCED_VECTOR_CONSTEXPR iterator insert(const_iterator pos, T&& value) {
+        return Insert(pos, std::move(value));
+    }
+
+    iterator insert(const_iterator pos, size_type count, const T& value) {
+        return Insert(pos, count, value);
+    }
+
+    template <typename InputIterator, detail::RequireInputIterator<InputIterator> = 0>
+    iterator insert(const_iterator pos, InputIterator first, InputIterator last) {
+        return Insert(pos, first, last);
     }
 
-    T& operator[](size_t index) noexcept {
-        assert(index < size_);
-        return data_[index];
+    iterator erase(const_iterator pos) {
+        return Erase(pos);
     }
 
-    ~Vector() {
+    iterator erase(const_iterator first, const_iterator last) {
+        return Erase(first, last);
+    }
+
+    template <typename InputIterator, detail::RequireInputIterator<InputIterator> = 0>
+    void assign(InputIterator first, InputIterator last) {
+        Assign(first, last);
+    }
+
+    void assign(size_type count, const T& value) {
+        Clear();
+        Insert(end(), count, value);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR void swap(Vector& other) noexcept {
+        Swap(other);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR friend void swap(Vector& lhs, Vector& rhs) noexcept {
+        lhs.Swap(rhs);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR friend bool operator==(const Vector& lhs, const Vector& rhs) {
+        return lhs.size_ == rhs.size_ && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR friend bool operator!=(const Vector& lhs, const Vector& rhs) {
+        return !(lhs == rhs);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR friend bool operator<(const Vector& lhs, const Vector& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR friend bool operator>(const Vector& lhs, const Vector& rhs) {
+        return rhs < lhs;
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR friend bool operator<=(const Vector& lhs, const Vector& rhs) {
+        return !(rhs < lhs);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR friend bool operator>=(const Vector& lhs, const Vector& rhs) {
+        return !(lhs < rhs);
+    }
+
+    ADVANCED_VECTOR_CONSTEXPR ~Vector() {
         std::destroy_n(data_.GetAddress(), size_);
     }
 
 private:
-    static constexpr bool CanMove() {
-        return std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+    // Обменивает содержимое вместе с аллокаторами, не проверяя правила их распространения
+    ADVANCED_VECTOR_CONSTEXPR void SwapData(Vector& other) noexcept {
+        data_.Swap(other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    // Наименьшее число элементов в части параллельной операции
+    static constexpr size_t ChunkSize() noexcept {
+        return std::max<size_t>(PARALLEL_MIN_CHUNK_BYTES / sizeof(T), 1);
+    }
+
+    // Создаёт n элементов в неинициализированной памяти data: construct(begin, end) создаёт элементы
+    // с begin по end, не оставляя частично созданных при исключении
+    template <typename Construct>
+    static void ParallelConstruct(ParallelTag policy, T* data, size_t n, Construct construct) {
+        detail::ParallelFor(policy, n, ChunkSize(), construct, [data](size_t begin, size_t end) noexcept {
+            std::destroy(data + begin, data + end);
+        });
+    }
+
+    static void ParallelDestroy(ParallelTag policy, T* data, size_t n) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            try {
+                detail::ParallelFor(policy, n, ChunkSize(), [data](size_t begin, size_t end) noexcept {
+                    std::destroy(data + begin, data + end);
+                }, [](size_t, size_t) noexcept {});
+            } catch (...) {
+                // Не хватило памяти для запуска потоков: ни один элемент ещё не уничтожен
+                std::destroy_n(data, n);
+            }
+        }
+    }
+
+    template <typename... Args>
+    ADVANCED_VECTOR_COLD ADVANCED_VECTOR_CONSTEXPR T& GrowAndEmplaceBack(Args&&... args) {
+        InsertWithReallocation(size_, std::forward<Args>(args)...);
+        ++size_;
+        return data_.GetAddress()[size_ - 1];
+    }
+
+    // Ёмкость буфера, которую выбирает политика роста для вставки, требующей required элементов
+    ADVANCED_VECTOR_CONSTEXPR size_t NextCapacity(size_t required) const noexcept {
+        return GrowthPolicy::NextCapacity(data_.Capacity(), required, sizeof(T));
     }
 
     template<typename... Args>
-    void InsertWithReallocation(size_t index, Args&&... args)
+    ADVANCED_VECTOR_CONSTEXPR void InsertWithReallocation(size_t index, Args&&... args)
     {
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-        new (new_data + index) T(std::forward<Args>(args)...);
-        try {
-            MoveOrCopyN(data_.GetAddress(), index, new_data.GetAddress());
-        } catch (...) {
-            std::destroy_at(new_data + index);
-            throw;
+        const size_t new_capacity = NextCapacity(size_ + 1);
+        // Расширение на месте не перемещает элементы, поэтому аргументы, ссылающиеся на них, остаются валидными
+        if (data_.TryExpand(new_capacity)) {
+            InsertWithoutReallocation(index, std::forward<Args>(args)...);
+            return;
         }
-        try {
-            MoveOrCopyN(data_.GetAddress() + index, size_ - index, new_data.GetAddress() + index + 1);
-        } catch (...) {
-            std::destroy_n(new_data.GetAddress(), index + 1);
-            throw;
+        if constexpr (IsTriviallyRelocatableV<T> && Memory::CanReallocate()) {
+            // Аргументы могут ссылаться на элементы, которые переедут вместе с буфером, поэтому элемент
+            // создаётся заранее во внешней памяти и после перевыделения переносится на место побайтово
+            alignas(T) unsigned char value[sizeof(T)];
+            T* const ptr = new (value) T(std::forward<Args>(args)...);
+            try {
+                data_.Reallocate(new_capacity);
+            } catch (...) {
+                std::destroy_at(ptr);
+                throw;
+            }
+            Ops::ShiftInBitwise(data_.GetAddress(), size_, index, ptr);
+        } else {
+            InsertIntoNewBuffer(new_capacity, index, std::forward<Args>(args)...);
         }
+    }
 
-        std::destroy_n(data_.GetAddress(), size_);
-        data_.Swap(new_data);
+    template <typename Construct>
+    ADVANCED_VECTOR_CONSTEXPR void ResizeWith(size_t new_size, Construct construct) {
+        if(size_ == new_size) {
+            return;
+        }
+        if(new_size < size_) {
+            std::destroy(data_.GetAddress() + new_size, data_.GetAddress() + size_);
+        } else {
+            Reserve(new_size);
+            construct(data_.GetAddress() + size_, data_.GetAddress() + new_size);
+        }
+        size_ = new_size;
     }
 
-    template<typename... Args>
-    void InsertWithoutReallocation(size_t index, Args&&... args)
-    {
-        if(index == size_)
-        {
-            new (data_ + size_) T(std::forward<Args>(args)...);
+    // Вставляет count элементов в позицию index. construct(dst, offset, n) создаёт в неинициализированной
+    // памяти dst элементы вставляемой последовательности с offset по offset + n, не оставляя
+    // частично созданных элементов при исключении; assign(dst, offset, n) присваивает их существующим
+    template <typename Construct, typename AssignTo>
+    iterator InsertN(size_t index, size_t count, Construct construct, AssignTo assign) {
+        // Сравнение со свободным местом, а не size_ + count с ёмкостью, не переполняется: иначе GCC
+        // допускает путь без роста при огромном size_ и предупреждает о размере сдвига в memmove
+        if (count > data_.Capacity() - size_) {
+            const size_t new_capacity = NextCapacity(size_ + count);
+            if (!data_.TryExpand(new_capacity)) {
+                if constexpr (Ops::CanShiftBitwise() && Memory::CanReallocate()) {
+                    data_.Reallocate(new_capacity);
+                } else {
+                    Memory new_data(new_capacity, data_.GetAllocator());
+                    construct(new_data.GetAddress() + index, 0, count);
+                    Ops::RelocateAround(data_.GetAddress(), size_, index, count, new_data.GetAddress());
+                    data_.Swap(new_data);
+                    size_ += count;
+                    return begin() + index;
+                }
+            }
         }
-        else
-        {
-            T tmp(std::forward<Args>(args)...);
-            new (data_ + size_) T(std::forward<T>(data_[size_ - 1]));
+
+        T* const pos = data_.GetAddress() + index;
+        T* const old_end = data_.GetAddress() + size_;
+        const size_t elems_after = size_ - index;
+        if constexpr (Ops::CanShiftBitwise()) {
+            std::memmove(static_cast<void*>(pos + count), pos, elems_after * sizeof(T));
+            try {
+                construct(pos, 0, count);
+            } catch (...) {
+                std::memmove(static_cast<void*>(pos), pos + count, elems_after * sizeof(T));
+                throw;
+            }
+            size_ += count;
+        } else if (elems_after > count) {
+            Ops::MoveOrCopyN(old_end - count, count, old_end);
+            size_ += count;
+            std::move_backward(pos, old_end - count, old_end);
+            assign(pos, 0, count);
+        } else {
+            construct(old_end, elems_after, count - elems_after);
+            size_ += count - elems_after;
             try {
-                std::move_backward(data_ + index, data_ + (size_ - 1), data_ + size_);
+                Ops::MoveOrCopyN(pos, elems_after, pos + count);
             } catch (...) {
-                std::destroy_at(data_ + size_);
+                std::destroy_n(old_end, count - elems_after);
+                size_ -= count - elems_after;
                 throw;
             }
-            data_[index] = std::forward<T>(tmp);
+            size_ += elems_after;
+            assign(pos, 0, elems_after);
         }
+        return begin() + index;
     }
 
-    template <typename InputIterator, typename ForwardIterator>
-    void MoveOrCopyN(InputIterator first, size_t n, ForwardIterator result)
-    {
-        if constexpr (CanMove()) {
-            std::uninitialized_move_n(first, n, result);
+    // Заменяет все элементы count элементами, скопированными из first, в буфере ёмкости count.
+    // Тривиально копируемые элементы при аллокаторе с reallocate копируются в перевыделенный на месте
+    // буфер: аллокатор может не допускать второго буфера одновременно с первым (FileMappedAllocator),
+    // а при исключении из reallocate прежние элементы остаются нетронутыми. Иначе элементы копируются
+    // в новый буфер, который заменяет старый только после успешного копирования
+    template <typename ForwardIterator>
+    void GrowForOverwrite(size_t count, ForwardIterator first) {
+        if constexpr (std::is_trivially_copyable_v<T> && Memory::CanReallocate()) {
+            data_.Reallocate(count);
+            Ops::CopyN(first, count, data_.GetAddress());
         } else {
-            std::uninitialized_copy_n(first, n, result);
+            Memory new_data(count, data_.GetAllocator());
+            Ops::CopyN(first, count, new_data.GetAddress());
+            std::destroy_n(data_.GetAddress(), size_);
+            data_.Swap(new_data);
         }
     }
 
+    template<typename... Args>
+    ADVANCED_VECTOR_CONSTEXPR void InsertIntoNewBuffer(size_t new_capacity, size_t index, Args&&... args)
+    {
+        Memory new_data(new_capacity, data_.GetAllocator());
+        Ops::InsertIntoBuffer(data_.GetAddress(), size_, index, new_data.GetAddress(), std::forward<Args>(args)...);
+        data_.Swap(new_data);
+    }
+
+    template<typename... Args>
+    ADVANCED_VECTOR_CONSTEXPR void InsertWithoutReallocation(size_t index, Args&&... args)
+    {
+        Ops::InsertWithoutReallocation(data_.GetAddress(), size_, index, std::forward<Args>(args)...);
+    }
+
 private:
-    RawMemory<T> data_;
+    Memory data_;
     size_t size_ = 0;
-};
\ No newline at end of file
+};
+
+// Вектор, начало буфера которого всегда выровнено по границе Alignment байт
+template <typename T, size_t Alignment = CACHE_LINE_SIZE>
+using AlignedVector = Vector<T, AlignedAllocator<T, Alignment>>;